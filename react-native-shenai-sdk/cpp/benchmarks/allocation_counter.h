@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace shen::benchmarks {
+
+/**
+ * Gets the number of calls to the global operator new made by the process so far.
+ * Linking allocation_counter.cpp into an executable replaces the global allocation functions with counting ones.
+ */
+std::uint64_t GetAllocationCount();
+
+}  // namespace shen::benchmarks
@@ -0,0 +1,143 @@
+// Compares the batch BMI helpers with scalar loops over the same columns: ClassifyBmi, and AdjustBmiWeightHeight
+// with and without rounding. The batch results are checked to be bit-identical to the scalar ones; the classified
+// values also include every category boundary, its floating-point neighbours and values that have no category.
+//
+// usage: bmi_benchmark [records] [threads]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "bmi_batch.h"
+
+namespace {
+
+struct bmi_columns {
+  std::vector<double> bmi;
+  std::vector<double> weight;
+  std::vector<double> height;
+};
+
+bmi_columns GenerateColumns(std::size_t count) {
+  std::mt19937_64 rng(42);
+  std::normal_distribution<double> height(172.0, 9.0);
+  std::normal_distribution<double> bmi(26.0, 4.5);
+  std::normal_distribution<double> noise(0.0, 0.3);
+  bmi_columns columns;
+  columns.bmi.resize(count);
+  columns.weight.resize(count);
+  columns.height.resize(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    columns.height[i] = std::clamp(height(rng), 140.0, 210.0);
+    columns.bmi[i] = std::clamp(bmi(rng), 13.0, 50.0);
+    // Weight that does not quite agree with the BMI, as in measured data.
+    columns.weight[i] = columns.bmi[i] * columns.height[i] * columns.height[i] * 1e-4 + noise(rng);
+  }
+  return columns;
+}
+
+// The category boundaries with their neighbours, then values the scalar classifyBmi has no category for.
+std::vector<double> EdgeValues() {
+  std::vector<double> values;
+  for (const auto& [category, range] : mx::kBmiRanges) {
+    for (const double bound : {range.first, range.second}) {
+      values.push_back(std::nextafter(bound, -std::numeric_limits<double>::infinity()));
+      values.push_back(bound);
+      values.push_back(std::nextafter(bound, std::numeric_limits<double>::infinity()));
+    }
+  }
+  values.insert(values.end(), {-0.0, -1.0, std::numeric_limits<double>::quiet_NaN(),
+                               -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::max()});
+  return values;
+}
+
+bool BitIdentical(const std::vector<double>& a, const std::vector<double>& b) {
+  return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+// Best time per record, in nanoseconds, of `fn` run on a fresh copy of the columns.
+template <typename Fn>
+double BestNanosecondsPerRecord(const bmi_columns& input, bmi_columns& output, int repetitions, Fn&& fn) {
+  double best = 0.0;
+  for (int r = 0; r < repetitions; ++r) {
+    output = input;
+    const auto start = std::chrono::steady_clock::now();
+    fn(output);
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    const double per_record = elapsed.count() / static_cast<double>(input.bmi.size());
+    best = r == 0 ? per_record : std::min(best, per_record);
+  }
+  return best;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  const unsigned threads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 0;
+  constexpr int kRepetitions = 5;
+
+  const bmi_columns input = GenerateColumns(count);
+  shen::thread_pool pool(threads);
+  shen::thread_pool single(1);
+  std::printf("records: %zu, threads: %u\n\n", count, pool.GetThreadCount());
+  std::printf("%-32s %10s %10s\n", "path", "ns/rec", "identical");
+
+  bool all_identical = true;
+  for (const bool round : {false, true}) {
+    bmi_columns scalar;
+    bmi_columns batch;
+    const double scalar_ns = BestNanosecondsPerRecord(input, scalar, kRepetitions, [round](bmi_columns& c) {
+      for (std::size_t i = 0; i < c.bmi.size(); ++i) {
+        mx::adjustBmiWeightHeight(c.bmi[i], c.weight[i], c.height[i], round);
+      }
+    });
+    const double single_ns = BestNanosecondsPerRecord(input, batch, kRepetitions, [&](bmi_columns& c) {
+      shen::AdjustBmiWeightHeight(c.bmi, c.weight, c.height, round, single);
+    });
+    const double pool_ns = BestNanosecondsPerRecord(input, batch, kRepetitions, [&](bmi_columns& c) {
+      shen::AdjustBmiWeightHeight(c.bmi, c.weight, c.height, round, pool);
+    });
+    const bool identical =
+        BitIdentical(scalar.bmi, batch.bmi) && BitIdentical(scalar.weight, batch.weight) &&
+        BitIdentical(scalar.height, batch.height);
+    all_identical = all_identical && identical;
+    std::printf("%-32s %10.2f\n", round ? "adjust (rounded), scalar" : "adjust, scalar", scalar_ns);
+    std::printf("%-32s %10.2f\n", round ? "adjust (rounded), batch 1 thread" : "adjust, batch 1 thread", single_ns);
+    std::printf("%-32s %10.2f %10s\n", round ? "adjust (rounded), batch pool" : "adjust, batch pool", pool_ns,
+                identical ? "yes" : "NO");
+  }
+
+  bmi_columns classified = input;
+  const std::vector<double> edges = EdgeValues();
+  classified.bmi.insert(classified.bmi.end(), edges.begin(), edges.end());
+  const std::size_t classified_count = classified.bmi.size();
+  std::vector<std::optional<mx::BmiCategory>> scalar_categories(classified_count);
+  std::vector<mx::BmiCategory> batch_categories(classified_count);
+  std::vector<std::uint8_t> batch_valid(classified_count);
+  bmi_columns unused;
+  const double classify_scalar_ns = BestNanosecondsPerRecord(classified, unused, kRepetitions, [&](bmi_columns& c) {
+    for (std::size_t i = 0; i < classified_count; ++i) {
+      scalar_categories[i] = mx::classifyBmi(c.bmi[i]);
+    }
+  });
+  const double classify_batch_ns = BestNanosecondsPerRecord(
+      classified, unused, kRepetitions,
+      [&](bmi_columns& c) { shen::ClassifyBmi(c.bmi, batch_categories, batch_valid); });
+  bool classify_identical = true;
+  for (std::size_t i = 0; i < classified_count; ++i) {
+    const auto batch = batch_valid[i] != 0 ? std::optional<mx::BmiCategory>(batch_categories[i]) : std::nullopt;
+    classify_identical = classify_identical && batch == scalar_categories[i];
+  }
+  std::printf("%-32s %10.2f\n", "classify, scalar", classify_scalar_ns);
+  std::printf("%-32s %10.2f %10s\n", "classify, batch", classify_batch_ns, classify_identical ? "yes" : "NO");
+  return all_identical && classify_identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
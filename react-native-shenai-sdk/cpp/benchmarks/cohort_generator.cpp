@@ -0,0 +1,93 @@
+#include "cohort_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <random>
+
+namespace shen::benchmarks {
+
+namespace {
+
+using namespace mx::health_risks;
+
+constexpr std::array<const char*, 12> kCountries = {"US", "PL", "DE", "GB", "FR", "ES",
+                                                    "IT", "IN", "BR", "JP", "NG", "SE"};
+constexpr std::array<double, 12> kCountryWeights = {20, 12, 10, 9, 8, 7, 7, 8, 6, 5, 4, 4};
+
+template <typename T>
+T Clamp(T value, T low, T high) {
+  return std::min(std::max(value, low), high);
+}
+
+}  // namespace
+
+std::vector<RisksFactors> GenerateCohort(std::size_t count, const cohort_settings& settings) {
+  std::mt19937_64 rng(settings.seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  auto chance = [&](double p) { return unit(rng) < p; };
+  auto keep = [&] { return !chance(settings.field_dropout); };
+
+  std::uniform_int_distribution<int> age(30, 79);
+  std::normal_distribution<float> sbp(128.0f, 17.0f);
+  std::normal_distribution<float> cholesterol(205.0f, 40.0f);
+  std::normal_distribution<float> hdl(52.0f, 14.0f);
+  std::normal_distribution<float> male_height(176.0f, 7.5f);
+  std::normal_distribution<float> female_height(163.0f, 7.0f);
+  std::normal_distribution<float> bmi(27.0f, 4.8f);
+  std::lognormal_distribution<float> triglyceride(4.9f, 0.45f);
+  std::normal_distribution<float> glucose(98.0f, 16.0f);
+  std::discrete_distribution<std::size_t> country(kCountryWeights.begin(), kCountryWeights.end());
+  std::discrete_distribution<int> gender({49, 49, 2});
+  std::discrete_distribution<int> race({70, 15, 15});
+  std::normal_distribution<float> dbp_noise(0.0f, 6.0f);
+
+  std::vector<RisksFactors> cohort(count);
+  for (auto& f : cohort) {
+    const Gender g = static_cast<Gender>(gender(rng));
+    const int a = age(rng);
+    const float systolic = Clamp(sbp(rng) + 0.4f * (a - 50), 90.0f, 200.0f);
+
+    f.age = a;
+    f.gender = g;
+    f.sbp = systolic;
+    if (keep()) f.dbp = Clamp(0.55f * systolic + 10.0f + dbp_noise(rng), 50.0f, 120.0f);
+    if (keep()) f.country = kCountries[country(rng)];
+
+    if (chance(settings.minimal_share)) {
+      continue;
+    }
+
+    if (keep()) f.is_smoker = chance(0.18);
+    if (keep()) f.has_diabetes = chance(0.02 + 0.002 * (a - 30));
+    if (keep()) {
+      f.hypertension_treatment = systolic < 130 ? HypertensionTreatment::not_needed
+                                 : chance(0.5)  ? HypertensionTreatment::yes
+                                                : HypertensionTreatment::no;
+    }
+    if (keep()) f.race = static_cast<Race>(race(rng));
+
+    const float height = Clamp(g == Gender::female ? female_height(rng) : male_height(rng), 140.0f, 210.0f);
+    const float body_mass_index = Clamp(bmi(rng), 16.0f, 50.0f);
+    if (keep()) f.body_height = height;
+    if (keep()) f.body_weight = body_mass_index * height * height * 1e-4f;
+    if (keep()) f.waist_circumference = Clamp(2.9f * body_mass_index + 10.0f, 55.0f, 160.0f);
+    if (keep()) f.physical_activity = static_cast<PhysicalActivity>(rng() % 5);
+
+    if (chance(settings.lipid_panel_share)) {
+      if (keep()) f.cholesterol = Clamp(cholesterol(rng), 110.0f, 350.0f);
+      if (keep()) f.cholesterol_hdl = Clamp(hdl(rng), 20.0f, 110.0f);
+      if (keep()) f.triglyceride = Clamp(triglyceride(rng), 40.0f, 600.0f);
+      if (keep()) f.fasting_glucose = Clamp(glucose(rng), 60.0f, 250.0f);
+    }
+
+    if (keep()) f.parental_hypertension = static_cast<ParentalHistory>(rng() % 3);
+    if (keep()) f.family_diabetes = static_cast<FamilyHistory>(rng() % 3);
+    if (keep()) f.vegetable_fruit_diet = chance(0.6);
+    if (keep()) f.history_of_high_glucose = chance(0.08);
+    if (keep()) f.history_of_hypertension = chance(0.25);
+  }
+  return cohort;
+}
+
+}  // namespace shen::benchmarks
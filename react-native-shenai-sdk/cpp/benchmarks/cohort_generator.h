@@ -0,0 +1,31 @@
+#pragma once
+
+#include <ShenaiSDK/health_risks_factors.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace shen::benchmarks {
+
+/**
+ * Settings of the synthetic cohort generator.
+ */
+struct cohort_settings {
+  std::uint64_t seed{42};
+  // Probability of dropping any individual optional field on top of the record's missing-field pattern.
+  double field_dropout{0.05};
+  // Share of records with a lipid panel (cholesterol and HDL); the rest are BMI-based.
+  double lipid_panel_share{0.6};
+  // Share of records with only the minimal factor set (age, gender, blood pressure).
+  double minimal_share{0.1};
+};
+
+/**
+ * Generates `count` records with realistic marginal distributions of the risk factors (adults aged 30-79,
+ * blood pressure, lipids and anthropometrics in mg/dL, mmHg, cm and kg), a mix of genders, races and countries, and
+ * varying missing-field patterns. The same settings always yield the same cohort.
+ */
+std::vector<mx::health_risks::RisksFactors> GenerateCohort(std::size_t count, const cohort_settings& settings = {});
+
+}  // namespace shen::benchmarks
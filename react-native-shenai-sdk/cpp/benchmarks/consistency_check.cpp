@@ -0,0 +1,173 @@
+// Checks that the memoized and derived health-risk paths return exactly what the direct SDK calls return, over a
+// synthetic cohort. Prints the number of mismatching records per check and fails if any check has one.
+//
+// usage: consistency_check [records] [seed]
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "bmi_batch.h"
+#include "cohort_generator.h"
+#include "health_risks_cache.h"
+#include "packed_risks.h"
+#include "risks_factors_columns.h"
+#include "risks_factors_hash.h"
+
+using mx::health_risks::HealthRisks;
+using mx::health_risks::RisksFactors;
+
+namespace {
+
+template <typename T>
+bool Same(const std::optional<T>& a, const std::optional<T>& b) {
+  if (!a || !b) {
+    return !a && !b;
+  }
+  if constexpr (std::is_floating_point_v<T>) {
+    if (std::isnan(*a) || std::isnan(*b)) {
+      return std::isnan(*a) && std::isnan(*b);
+    }
+  }
+  return *a == *b;
+}
+
+bool Same(const HealthRisks& a, const HealthRisks& b) {
+  const auto& ah = a.hard_and_fatal_events;
+  const auto& bh = b.hard_and_fatal_events;
+  const auto& ac = a.cv_diseases;
+  const auto& bc = b.cv_diseases;
+  const auto& as = a.scores;
+  const auto& bs = b.scores;
+  return Same(a.wellness_score, b.wellness_score) && Same(ah.coronary_death_event_risk, bh.coronary_death_event_risk) &&
+         Same(ah.fatal_stroke_event_risk, bh.fatal_stroke_event_risk) &&
+         Same(ah.total_cv_mortality_risk, bh.total_cv_mortality_risk) &&
+         Same(ah.hard_cv_event_risk, bh.hard_cv_event_risk) && Same(ac.overall_risk, bc.overall_risk) &&
+         Same(ac.coronary_heart_disease_risk, bc.coronary_heart_disease_risk) &&
+         Same(ac.stroke_risk, bc.stroke_risk) && Same(ac.heart_failure_risk, bc.heart_failure_risk) &&
+         Same(ac.peripheral_vascular_disease_risk, bc.peripheral_vascular_disease_risk) &&
+         Same(a.vascular_age, b.vascular_age) && Same(as.age_score, bs.age_score) &&
+         Same(as.sbp_score, bs.sbp_score) && Same(as.smoking_score, bs.smoking_score) &&
+         Same(as.diabetes_score, bs.diabetes_score) && Same(as.bmi_score, bs.bmi_score) &&
+         Same(as.cholesterol_score, bs.cholesterol_score) &&
+         Same(as.cholesterol_hdl_score, bs.cholesterol_hdl_score) && Same(as.total_score, bs.total_score) &&
+         Same(a.waist_to_height_ratio, b.waist_to_height_ratio) && Same(a.body_fat_percentage, b.body_fat_percentage) &&
+         Same(a.basal_metabolic_rate, b.basal_metabolic_rate) &&
+         Same(a.body_roundness_index, b.body_roundness_index) && Same(a.conicity_index, b.conicity_index) &&
+         Same(a.a_body_shape_index, b.a_body_shape_index) &&
+         Same(a.total_daily_energy_expenditure, b.total_daily_energy_expenditure) &&
+         Same(a.hypertension_risk, b.hypertension_risk) && Same(a.diabetes_risk, b.diabetes_risk) &&
+         a.non_alcoholic_fatty_liver_disease_risk == b.non_alcoholic_fatty_liver_disease_risk;
+}
+
+struct check {
+  const char* name;
+  std::size_t mismatches;
+};
+
+// Each record is looked up twice, so both the evaluating and the memoized lookup are compared.
+check CheckHealthRisksCache(const std::vector<RisksFactors>& cohort) {
+  shen::health_risks_cache cache(4 * cohort.size());
+  std::size_t mismatches = 0;
+  for (int pass = 0; pass < 2; ++pass) {
+    for (const RisksFactors& f : cohort) {
+      if (!Same(cache.ComputeHealthRisks(f), shen::ComputeHealthRisks(f)) ||
+          !Same(cache.GetMinimalRisks(f), shen::GetMinimalRisks(f)) ||
+          !Same(cache.GetMaximalRisks(f), shen::GetMaximalRisks(f)) ||
+          !Same(cache.GetReferenceRisks(f), shen::GetReferenceRisks(f))) {
+        ++mismatches;
+      }
+    }
+  }
+  return {"health_risks_cache", mismatches};
+}
+
+// kBmiCategoryLowerBounds against the lower bounds in mx::kBmiRanges, one mismatch per category.
+check CheckBmiLowerBounds() {
+  std::size_t mismatches = 0;
+  for (const auto& [category, range] : mx::kBmiRanges) {
+    const auto index = static_cast<std::size_t>(category);
+    if (index > shen::kBmiCategoryLowerBounds.size() ||
+        range.first != (index == 0 ? 0.0 : shen::kBmiCategoryLowerBounds[index - 1])) {
+      ++mismatches;
+    }
+  }
+  if (mx::kBmiRanges.size() != shen::kBmiCategoryLowerBounds.size() + 1) {
+    ++mismatches;
+  }
+  return {"BMI category lower bounds", mismatches};
+}
+
+// The cohort with some countries replaced by strings the cohort generator never produces: lower case, too long and
+// not letters.
+std::vector<RisksFactors> WithUnusualCountries(std::vector<RisksFactors> cohort) {
+  const char* const kCountries[] = {"pl", "Us", "USA", "1A", "Deutschland"};
+  for (std::size_t i = 0; i < cohort.size(); i += 7) {
+    cohort[i].country = kCountries[(i / 7) % (sizeof(kCountries) / sizeof(kCountries[0]))];
+  }
+  return cohort;
+}
+
+// GetRow(ToColumns(x)) == x for every record.
+check CheckColumnsRoundTrip(const std::vector<RisksFactors>& cohort) {
+  shen::risks_factors_columns columns;
+  shen::ToColumns(cohort, columns);
+  std::size_t mismatches = 0;
+  RisksFactors row;
+  for (std::size_t i = 0; i < cohort.size(); ++i) {
+    shen::GetRow(columns, i, row);
+    if (!shen::RisksFactorsEqual(row, cohort[i])) {
+      ++mismatches;
+    }
+  }
+  return {"columns round trip", mismatches};
+}
+
+// Unpack(Pack(x)) == x for every record Pack accepts. Pack rejects exactly the countries that are neither empty nor
+// two ASCII letters; the ages of the cohort fit in 16 bits.
+check CheckPackedRoundTrip(const std::vector<RisksFactors>& cohort) {
+  std::size_t mismatches = 0;
+  RisksFactors row;
+  for (const RisksFactors& f : cohort) {
+    const auto packed = shen::Pack(f);
+    const bool representable = shen::country_code::FromString(f.country).has_value();
+    if (packed.has_value() != representable) {
+      ++mismatches;
+      continue;
+    }
+    if (packed) {
+      shen::Unpack(*packed, row);
+      if (!shen::RisksFactorsEqual(row, f)) {
+        ++mismatches;
+      }
+    }
+  }
+  return {"packed round trip", mismatches};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+  shen::benchmarks::cohort_settings settings;
+  if (argc > 2) {
+    settings.seed = std::strtoull(argv[2], nullptr, 10);
+  }
+  const std::vector<RisksFactors> cohort = shen::benchmarks::GenerateCohort(count, settings);
+
+  const std::vector<RisksFactors> unusual = WithUnusualCountries(cohort);
+
+  const check checks[] = {CheckHealthRisksCache(cohort), CheckColumnsRoundTrip(unusual), CheckPackedRoundTrip(unusual),
+                          CheckBmiLowerBounds()};
+
+  std::size_t failed = 0;
+  std::printf("records: %zu\n", count);
+  for (const check& c : checks) {
+    std::printf("%-28s %zu mismatches\n", c.name, c.mismatches);
+    failed += c.mismatches != 0 ? 1 : 0;
+  }
+  return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,73 @@
+// Unit tests of cursor_ring: incremental reads by independent cursors, partial reads, and resuming at the oldest item
+// once the items after a cursor were evicted.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "cursor_ring.h"
+
+namespace {
+
+int g_failures = 0;
+
+void Expect(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    ++g_failures;
+  }
+}
+
+void TestIncrementalReads() {
+  shen::cursor_ring<int> ring(8);
+  std::vector<int> out(8);
+  const shen::span<int> all(out.data(), out.size());
+  std::uint64_t first = 0;
+  std::uint64_t second = 0;
+  Expect(ring.Read(first, all) == 0 && first == 0, "an empty ring reads nothing");
+
+  ring.Push(10);
+  ring.Push(11);
+  Expect(ring.Read(first, all) == 2 && out[0] == 10 && out[1] == 11 && first == 2, "a read copies the new items");
+  Expect(ring.Read(first, all) == 0, "a read at the end copies nothing");
+  ring.Push(12);
+  Expect(ring.Read(first, all) == 1 && out[0] == 12 && first == ring.GetEnd(), "a read copies only the newer items");
+  Expect(ring.Read(second, all) == 3 && out[0] == 10 && out[2] == 12, "cursors are independent");
+
+  std::uint64_t partial = 0;
+  Expect(ring.Read(partial, shen::span<int>(out.data(), 2)) == 2 && partial == 2, "a read stops at the output size");
+  Expect(ring.Read(partial, all) == 1 && out[0] == 12, "the next read continues after a partial read");
+}
+
+void TestEvictedItemsAreSkipped() {
+  shen::cursor_ring<int> ring(4);
+  std::vector<int> out(8);
+  const shen::span<int> all(out.data(), out.size());
+  std::uint64_t cursor = 0;
+  ring.Push(0);
+  Expect(ring.Read(cursor, all) == 1, "the first item is read");
+  for (int i = 1; i < 10; ++i) {
+    ring.Push(i);
+  }
+  Expect(ring.Read(cursor, all) == 4 && out[0] == 6 && out[3] == 9, "reading resumes at the oldest item kept");
+  Expect(cursor == 10 && ring.GetEnd() == 10, "the cursor ends past the newest item");
+
+  std::uint64_t ahead = 100;
+  Expect(ring.Read(ahead, all) == 0 && ahead == 10, "a cursor past the end is clamped to it");
+
+  shen::cursor_ring<int> minimal(0);
+  minimal.Push(1);
+  minimal.Push(2);
+  std::uint64_t start = 0;
+  Expect(minimal.Read(start, all) == 1 && out[0] == 2, "a zero capacity keeps the newest item");
+}
+
+}  // namespace
+
+int main() {
+  TestIncrementalReads();
+  TestEvictedItemsAreSkipped();
+  std::printf("cursor_ring_test: %d failures\n", g_failures);
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
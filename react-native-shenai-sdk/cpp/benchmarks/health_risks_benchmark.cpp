@@ -0,0 +1,137 @@
+// Throughput, latency and allocation benchmark of the health-risk entry points on a synthetic cohort.
+// Reports records/s, the p50/p99 latency of a single call and heap allocations per record for the single-call, batch
+// and cached paths. A batch call covers kBatchSize records, so its latency is that of the whole batch.
+//
+// usage: health_risks_benchmark [records] [threads] [seed]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "cohort_generator.h"
+#include "health_risks_batch.h"
+#include "health_risks_cache.h"
+
+using mx::health_risks::HealthRisks;
+using mx::health_risks::RisksFactors;
+using shen::benchmarks::GetAllocationCount;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t kBatchSize = 1024;
+
+struct path_result {
+  const char* path;
+  std::size_t records_per_call;
+  double records_per_second;
+  double p50_us;
+  double p99_us;
+  double allocations_per_record;
+};
+
+double Microseconds(clock_type::duration d) { return std::chrono::duration<double, std::micro>(d).count(); }
+
+double Percentile(std::vector<double> samples, double q) {
+  if (samples.empty()) {
+    return 0.0;
+  }
+  const std::size_t k = std::min(samples.size() - 1, static_cast<std::size_t>(q * samples.size()));
+  std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+  return samples[k];
+}
+
+path_result Summarize(const char* path, std::size_t records_per_call, std::size_t records, clock_type::duration total,
+                      const std::vector<double>& latencies_us, std::uint64_t allocations) {
+  return {path,
+          records_per_call,
+          records / std::chrono::duration<double>(total).count(),
+          Percentile(latencies_us, 0.50),
+          Percentile(latencies_us, 0.99),
+          static_cast<double>(allocations) / records};
+}
+
+// Each call timed individually.
+template <typename Fn>
+path_result MeasureCalls(const char* path, std::size_t count, Fn&& call) {
+  std::vector<double> latencies(count);
+  const std::uint64_t allocations = GetAllocationCount();
+  const auto start = clock_type::now();
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto call_start = clock_type::now();
+    call(i);
+    latencies[i] = Microseconds(clock_type::now() - call_start);
+  }
+  const auto total = clock_type::now() - start;
+  return Summarize(path, 1, count, total, latencies, GetAllocationCount() - allocations);
+}
+
+// Each batch of kBatchSize records timed as one call.
+template <typename Fn>
+path_result MeasureBatches(const char* path, std::size_t count, Fn&& batch) {
+  std::vector<double> latencies;
+  const std::uint64_t allocations = GetAllocationCount();
+  const auto start = clock_type::now();
+  for (std::size_t begin = 0; begin < count; begin += kBatchSize) {
+    const std::size_t size = std::min(kBatchSize, count - begin);
+    const auto batch_start = clock_type::now();
+    batch(begin, size);
+    latencies.push_back(Microseconds(clock_type::now() - batch_start));
+  }
+  const auto total = clock_type::now() - start;
+  return Summarize(path, std::min(kBatchSize, count), count, total, latencies, GetAllocationCount() - allocations);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  const unsigned threads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 0;
+  shen::benchmarks::cohort_settings settings;
+  if (argc > 3) {
+    settings.seed = std::strtoull(argv[3], nullptr, 10);
+  }
+
+  const std::vector<RisksFactors> cohort = shen::benchmarks::GenerateCohort(count, settings);
+  std::vector<HealthRisks> out(count);
+  shen::thread_pool pool(threads);
+  const shen::span<const RisksFactors> in(cohort);
+  const shen::span<HealthRisks> results(out);
+
+  std::vector<path_result> rows;
+  rows.push_back(MeasureCalls("single", count, [&](std::size_t i) { out[i] = shen::ComputeHealthRisks(cohort[i]); }));
+  rows.push_back(MeasureBatches("batch", count, [&](std::size_t begin, std::size_t size) {
+    shen::ComputeHealthRisks(in.subspan(begin, size), results.subspan(begin, size), pool);
+  }));
+
+  // What-if traffic: queries drawn with a skew from a pool of distinct factor sets, 20x smaller than the stream.
+  const std::size_t distinct = std::max<std::size_t>(1, count / 20);
+  std::mt19937_64 rng(settings.seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::vector<std::size_t> queries(count);
+  for (auto& q : queries) {
+    q = std::min(distinct - 1, static_cast<std::size_t>(std::pow(unit(rng), 3.0) * distinct));
+  }
+  shen::health_risks_cache cache;
+  rows.push_back(
+      MeasureCalls("cached", count, [&](std::size_t i) { out[i] = cache.ComputeHealthRisks(cohort[queries[i]]); }));
+  const shen::health_risks_cache_stats stats = cache.GetStats();
+
+  std::printf("records: %zu, threads: %u, seed: %llu\n", count, pool.GetThreadCount(),
+              static_cast<unsigned long long>(settings.seed));
+  std::printf("%-14s %10s %14s %16s %16s %12s\n", "path", "recs/call", "records/s", "call p50 [us]",
+              "call p99 [us]", "allocs/rec");
+  for (const auto& row : rows) {
+    std::printf("%-14s %10zu %14.0f %16.2f %16.2f %12.2f\n", row.path, row.records_per_call, row.records_per_second,
+                row.p50_us, row.p99_us, row.allocations_per_record);
+  }
+  std::printf("cache: %llu hits, %llu misses, capacity %zu\n", static_cast<unsigned long long>(stats.hits),
+              static_cast<unsigned long long>(stats.misses), stats.capacity);
+  return EXIT_SUCCESS;
+}
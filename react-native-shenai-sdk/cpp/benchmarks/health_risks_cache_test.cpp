@@ -0,0 +1,123 @@
+// Unit tests of health_risks_cache. The four SDK entry points the cache wraps are replaced by counting fakes defined
+// below, so the test links against no SDK library.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+
+#include "health_risks_cache.h"
+
+using mx::health_risks::HealthRisks;
+using mx::health_risks::RisksFactors;
+
+namespace {
+
+int g_evaluations = 0;
+
+// A result that identifies the query and the factors it was computed from.
+HealthRisks Fake(float query, const RisksFactors& risk_factors) {
+  ++g_evaluations;
+  HealthRisks health_risks;
+  health_risks.wellness_score = query;
+  health_risks.vascular_age = risk_factors.age;
+  return health_risks;
+}
+
+int g_failures = 0;
+
+void Expect(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    ++g_failures;
+  }
+}
+
+RisksFactors WithAge(int age) {
+  RisksFactors risk_factors;
+  risk_factors.age = age;
+  risk_factors.sbp = 120.0f;
+  return risk_factors;
+}
+
+void TestHitsAndMisses() {
+  shen::health_risks_cache cache(4);
+  g_evaluations = 0;
+  const RisksFactors f = WithAge(40);
+  cache.ComputeHealthRisks(f);
+  const HealthRisks again = cache.ComputeHealthRisks(f);
+  Expect(g_evaluations == 1, "a repeated query is served from the cache");
+  Expect(again.vascular_age == 40, "a hit returns the memoized result");
+  Expect(cache.GetMaximalRisks(f).wellness_score == 1.0f, "entry points are memoized separately");
+  const shen::health_risks_cache_stats stats = cache.GetStats();
+  Expect(stats.hits == 1 && stats.misses == 2 && stats.size == 2, "hits, misses and size are counted");
+}
+
+void TestLeastRecentlyUsedIsEvicted() {
+  shen::health_risks_cache cache(2);
+  g_evaluations = 0;
+  cache.ComputeHealthRisks(WithAge(1));
+  cache.ComputeHealthRisks(WithAge(2));
+  cache.ComputeHealthRisks(WithAge(1));
+  cache.ComputeHealthRisks(WithAge(3));  // evicts age 2
+  cache.ComputeHealthRisks(WithAge(1));
+  Expect(g_evaluations == 3, "the most recently used entry survives eviction");
+  cache.ComputeHealthRisks(WithAge(2));
+  Expect(g_evaluations == 4, "the least recently used entry is evicted");
+  Expect(cache.GetStats().size == 2, "the size stays within the capacity");
+  cache.SetCapacity(0);
+  Expect(cache.GetStats().size == 0, "a zero capacity drops every entry");
+}
+
+// NaN factors must match themselves: otherwise a NaN key is never found, neither by a lookup nor by eviction, and the
+// index keeps pointing at evicted entries.
+void TestNanKeysPastCapacity() {
+  shen::health_risks_cache cache(3);
+  g_evaluations = 0;
+  for (int i = 0; i < 20; ++i) {
+    RisksFactors f = WithAge(i % 5);
+    f.sbp = std::numeric_limits<float>::quiet_NaN();
+    f.cholesterol = i % 2 == 0 ? std::optional<float>(std::nanf("")) : std::nullopt;
+    cache.ComputeHealthRisks(f);
+    cache.ComputeHealthRisks(f);
+    Expect(cache.GetStats().size <= 3, "NaN keys are evicted");
+  }
+  Expect(g_evaluations == 20, "a NaN key is found again");
+  cache.Clear();
+  Expect(cache.GetStats().size == 0, "Clear drops NaN keys");
+}
+
+void TestSignedZeroesMatch() {
+  shen::health_risks_cache cache(2);
+  g_evaluations = 0;
+  RisksFactors f = WithAge(50);
+  f.dbp = 0.0f;
+  cache.ComputeHealthRisks(f);
+  f.dbp = -0.0f;
+  cache.ComputeHealthRisks(f);
+  Expect(g_evaluations == 1, "-0.0 and +0.0 are the same key");
+  f.dbp = 80.0f;
+  cache.ComputeHealthRisks(f);
+  Expect(g_evaluations == 2, "dbp is part of the key");
+}
+
+}  // namespace
+
+namespace shen {
+
+HealthRisks ComputeHealthRisks(const RisksFactors& risk_factors) { return Fake(0.0f, risk_factors); }
+HealthRisks GetMaximalRisks(const RisksFactors& risk_factors) { return Fake(1.0f, risk_factors); }
+HealthRisks GetMinimalRisks(const RisksFactors& risk_factors) { return Fake(2.0f, risk_factors); }
+HealthRisks GetReferenceRisks(const RisksFactors& risk_factors) { return Fake(3.0f, risk_factors); }
+
+}  // namespace shen
+
+int main() {
+  TestHitsAndMisses();
+  TestLeastRecentlyUsedIsEvicted();
+  TestNanKeysPastCapacity();
+  TestSignedZeroesMatch();
+  std::printf("health_risks_cache_test: %d failures\n", g_failures);
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
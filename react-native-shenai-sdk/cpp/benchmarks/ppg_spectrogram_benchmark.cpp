@@ -0,0 +1,82 @@
+// Measures the cost per hop of the incremental PPG spectrogram for several window and hop sizes, next to the cost of
+// transforming a whole measurement's signal at once.
+//
+// usage: ppg_spectrogram_benchmark [samples]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "ppg_spectrogram.h"
+#include "real_fft.h"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+std::vector<float> GenerateSignal(std::size_t count, float sample_rate_hz) {
+  std::mt19937 rng(7);
+  std::normal_distribution<float> noise(0.0f, 0.2f);
+  const double pi = std::acos(-1.0);
+  std::vector<float> samples(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const double t = static_cast<double>(i) / sample_rate_hz;
+    samples[i] = static_cast<float>(std::sin(2.0 * pi * 1.2 * t)) + noise(rng);
+  }
+  return samples;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1 << 18;
+  const float sample_rate_hz = shen::ppg_spectrogram::kDefaultSampleRateHz;
+  const std::vector<float> samples = GenerateSignal(count, sample_rate_hz);
+
+  std::printf("samples: %zu at %.0f Hz\n\n", count, sample_rate_hz);
+  std::printf("%-8s %-6s %10s %12s %14s\n", "window", "hop", "spectra", "ns per hop", "ns per sample");
+
+  double checksum = 0.0;
+  for (const std::size_t window_size : {128, 256, 512, 1024}) {
+    for (const std::size_t hop_size : {1, 8, 32}) {
+      shen::ppg_spectrogram spectrogram(
+          [&checksum](const shen::ppg_spectrum& spectrum) { checksum += spectrum.power[spectrum.power.size() / 8]; },
+          window_size, hop_size, sample_rate_hz);
+      const auto start = clock_type::now();
+      // Pushed a hop at a time.
+      std::size_t produced = 0;
+      for (std::size_t offset = 0; offset < count; offset += hop_size) {
+        produced += spectrogram.Push(
+            shen::span<const float>(samples.data() + offset, std::min(hop_size, count - offset)));
+      }
+      const double total = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+      std::printf("%-8zu %-6zu %10zu %12.1f %14.2f\n", window_size, hop_size, produced,
+                  total / static_cast<double>(produced), total / static_cast<double>(count));
+    }
+  }
+
+  // For comparison: transforming the signal of a whole measurement, as recomputing from GetFullPPGSignal would.
+  std::printf("\n%-8s %10s %12s\n", "signal", "transforms", "ns each");
+  for (const std::size_t signal_size : {1 << 12, 1 << 14}) {
+    shen::real_fft fft(signal_size);
+    std::vector<float> input(signal_size);
+    std::vector<float> power(fft.GetBinCount());
+    for (std::size_t i = 0; i < signal_size; ++i) {
+      input[i] = samples[i % count];
+    }
+    const std::size_t repeats = 200;
+    const auto start = clock_type::now();
+    for (std::size_t r = 0; r < repeats; ++r) {
+      fft.Power(input, power);
+      checksum += power[1];
+    }
+    const double total = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+    std::printf("%-8zu %10zu %12.1f\n", signal_size, repeats, total / static_cast<double>(repeats));
+  }
+  std::printf("\nchecksum: %g\n", checksum);
+  return 0;
+}
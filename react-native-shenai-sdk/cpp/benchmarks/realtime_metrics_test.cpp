@@ -0,0 +1,71 @@
+// Unit tests of realtime_metrics_publisher: change detection, the current values handed to new subscribers, and no
+// stale values after the publisher went idle.
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "realtime_metrics.h"
+
+namespace {
+
+int g_failures = 0;
+
+void Expect(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    ++g_failures;
+  }
+}
+
+shen::realtime_metrics_sample WithHeartRate(double timestamp_sec, double heart_rate_bpm) {
+  return {timestamp_sec, heart_rate_bpm, {}, {}, {}, {}};
+}
+
+void TestOnlyChangesArePublished() {
+  shen::realtime_metrics_publisher publisher;
+  const auto subscription = publisher.Subscribe();
+  Expect(publisher.Publish(WithHeartRate(1.0, 60.0)), "the first sample is published");
+  Expect(!publisher.Publish(WithHeartRate(2.0, 60.0)), "a sample with the same values is not published");
+  Expect(publisher.Publish(WithHeartRate(3.0, 61.0)), "a changed sample is published");
+  shen::realtime_metrics_sample sample{};
+  Expect(subscription->TryPop(sample) && sample.timestamp_sec == 1.0, "the first sample is queued");
+  Expect(subscription->TryPop(sample) && sample.timestamp_sec == 3.0, "the changed sample is queued");
+  Expect(!subscription->TryPop(sample), "nothing else is queued");
+}
+
+void TestNewSubscriberGetsCurrentValues() {
+  shen::realtime_metrics_publisher publisher;
+  const auto first = publisher.Subscribe();
+  publisher.Publish(WithHeartRate(1.0, 60.0));
+  const auto second = publisher.Subscribe();
+  publisher.Publish(WithHeartRate(2.0, 60.0));
+  shen::realtime_metrics_sample sample{};
+  Expect(second->TryPop(sample) && sample.heart_rate_bpm == 60.0, "a new subscriber gets the current values");
+  Expect(!second->TryPop(sample), "the unchanged sample is not delivered again");
+}
+
+void TestNoStaleValuesAfterIdle() {
+  shen::realtime_metrics_publisher publisher;
+  const auto first = publisher.Subscribe();
+  publisher.Publish(WithHeartRate(1.0, 60.0));
+  publisher.Unsubscribe(first);
+  Expect(!publisher.HasSubscriptions(), "the publisher goes idle with its last subscription");
+
+  // A source stops polling while the publisher is idle, so the next publish comes after the resubscription.
+  const auto second = publisher.Subscribe();
+  Expect(publisher.Publish(WithHeartRate(5.0, 60.0)), "the first sample after going idle is published");
+  shen::realtime_metrics_sample sample{};
+  Expect(second->TryPop(sample) && sample.timestamp_sec == 5.0, "the values from before going idle are not delivered");
+  Expect(!second->TryPop(sample), "only the fresh sample is delivered");
+}
+
+}  // namespace
+
+int main() {
+  TestOnlyChangesArePublished();
+  TestNewSubscriberGetsCurrentValues();
+  TestNoStaleValuesAfterIdle();
+  std::printf("realtime_metrics_test: %d failures\n", g_failures);
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
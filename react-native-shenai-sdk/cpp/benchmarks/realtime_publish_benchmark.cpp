@@ -0,0 +1,77 @@
+// Measures the cost of publishing a realtime metrics sample on the polling thread, for a growing number of
+// subscribers whose queues are drained concurrently by a consumer thread.
+//
+// usage: realtime_publish_benchmark [samples]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "realtime_metrics.h"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double Percentile(std::vector<double>& values, double q) {
+  const auto rank = static_cast<std::size_t>(q * static_cast<double>(values.size() - 1));
+  std::nth_element(values.begin(), values.begin() + rank, values.end());
+  return values[rank];
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+
+  std::printf("samples: %zu\n\n", count);
+  std::printf("%-12s %-10s %10s %10s %10s %10s\n", "subscribers", "values", "mean ns", "p50 ns", "p99 ns", "dropped");
+
+  for (const std::size_t subscriber_count : {0, 1, 4, 8}) {
+    for (const bool changing : {true, false}) {
+      shen::realtime_metrics_publisher publisher;
+      std::vector<std::shared_ptr<shen::realtime_metrics_subscription>> subscriptions;
+      for (std::size_t s = 0; s < subscriber_count; ++s) {
+        subscriptions.push_back(publisher.Subscribe());
+      }
+
+      std::atomic<bool> done{false};
+      std::thread consumer([&] {
+        std::vector<shen::realtime_metrics_sample> buffer(64);
+        while (!done.load(std::memory_order_relaxed)) {
+          for (const auto& subscription : subscriptions) {
+            subscription->Drain(buffer);
+          }
+          std::this_thread::yield();
+        }
+      });
+
+      std::vector<double> costs(count);
+      const auto start = clock_type::now();
+      for (std::size_t i = 0; i < count; ++i) {
+        const double heart_rate = changing ? 60.0 + static_cast<double>(i % 40) : 72.0;
+        const shen::realtime_metrics_sample sample{static_cast<double>(i), heart_rate, 42.0, {}, 1.5, {}};
+        const auto before = clock_type::now();
+        publisher.Publish(sample);
+        costs[i] = std::chrono::duration<double, std::nano>(clock_type::now() - before).count();
+      }
+      const double total = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+      done = true;
+      consumer.join();
+
+      std::uint64_t dropped = 0;
+      for (const auto& subscription : subscriptions) {
+        dropped += subscription->GetDroppedCount();
+      }
+      std::printf("%-12zu %-10s %10.1f %10.1f %10.1f %10llu\n", subscriber_count, changing ? "changing" : "unchanged",
+                  total / static_cast<double>(count), Percentile(costs, 0.5), Percentile(costs, 0.99),
+                  static_cast<unsigned long long>(dropped));
+    }
+  }
+  return 0;
+}
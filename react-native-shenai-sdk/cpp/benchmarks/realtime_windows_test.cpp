@@ -0,0 +1,193 @@
+// Unit tests of realtime_windows: the running metrics match a recomputation over each window's beats, a new
+// measurement clears the windows, polling follows the stream, and the windows are a reader of the stream for their
+// lifetime. GetRealtimeHeartbeats, the only SDK function reached, is replaced by a fake defined below.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "realtime_windows.h"
+
+using shen::heartbeat;
+using shen::realtime_window_metrics;
+using shen::realtime_windows;
+
+namespace {
+
+int g_failures = 0;
+
+void Expect(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    ++g_failures;
+  }
+}
+
+bool Near(const std::optional<double>& actual, const std::optional<double>& expected) {
+  if (actual.has_value() != expected.has_value()) {
+    return false;
+  }
+  return !actual || std::abs(*actual - *expected) <= 1e-9 * std::max(1.0, std::abs(*expected));
+}
+
+// Beats back to back from `start_sec`, with the given durations.
+std::vector<heartbeat> Beats(double start_sec, const std::vector<double>& durations_ms) {
+  std::vector<heartbeat> beats;
+  for (const double duration_ms : durations_ms) {
+    beats.push_back({start_sec, start_sec + duration_ms / 1000.0, duration_ms});
+    start_sec += duration_ms / 1000.0;
+  }
+  return beats;
+}
+
+// The window metrics recomputed from scratch over the beats that end within `period_sec` of the newest one.
+realtime_window_metrics Reference(const std::vector<heartbeat>& beats, float period_sec) {
+  std::vector<const heartbeat*> window;
+  for (const heartbeat& beat : beats) {
+    window.push_back(&beat);
+    while (window.size() > 1 && window.front()->end_location_sec <= beat.end_location_sec - period_sec) {
+      window.erase(window.begin());
+    }
+  }
+  realtime_window_metrics result{};
+  result.beat_count = static_cast<std::uint32_t>(window.size());
+  if (window.empty()) {
+    return result;
+  }
+  result.end_sec = window.back()->end_location_sec;
+  std::vector<double> durations;
+  for (const heartbeat* beat : window) {
+    durations.push_back(static_cast<double>(std::llround(beat->duration_ms)));
+  }
+  const auto n = static_cast<double>(durations.size());
+  double mean = 0.0;
+  for (const double d : durations) {
+    mean += d / n;
+  }
+  result.heart_rate_bpm = 60000.0 / mean;
+  if (durations.size() < 2) {
+    return result;
+  }
+  double squares = 0.0;
+  double successive = 0.0;
+  for (std::size_t i = 0; i < durations.size(); ++i) {
+    squares += (durations[i] - mean) * (durations[i] - mean);
+    if (i > 0) {
+      successive += (durations[i] - durations[i - 1]) * (durations[i] - durations[i - 1]);
+    }
+  }
+  result.hrv_sdnn_ms = std::sqrt(squares / (n - 1.0));
+  if (successive > 0.0) {
+    result.hrv_lnrmssd_ms = std::log(std::sqrt(successive / (n - 1.0)));
+  }
+  const auto [min, max] = std::minmax_element(durations.begin(), durations.end());
+  if (*max > *min) {
+    std::array<int, realtime_windows::kHistogramBinCount> histogram{};
+    for (const double d : durations) {
+      ++histogram[std::min<std::size_t>(static_cast<std::size_t>(d) / realtime_windows::kHistogramBinMs,
+                                        realtime_windows::kHistogramBinCount - 1)];
+    }
+    const auto mode = static_cast<std::size_t>(std::max_element(histogram.begin(), histogram.end()) -
+                                               histogram.begin());
+    const double mode_sec = (static_cast<double>(mode) + 0.5) * realtime_windows::kHistogramBinMs / 1000.0;
+    result.stress_index = 100.0 * histogram[mode] / n / (2.0 * mode_sec * (*max - *min) / 1000.0);
+  }
+  return result;
+}
+
+bool Matches(const realtime_window_metrics& actual, const realtime_window_metrics& expected) {
+  return actual.beat_count == expected.beat_count && actual.end_sec == expected.end_sec &&
+         Near(actual.heart_rate_bpm, expected.heart_rate_bpm) && Near(actual.hrv_sdnn_ms, expected.hrv_sdnn_ms) &&
+         Near(actual.hrv_lnrmssd_ms, expected.hrv_lnrmssd_ms) && Near(actual.stress_index, expected.stress_index);
+}
+
+void TestMatchesRecomputation() {
+  const std::vector<float> periods = {0.5f, 4.0f, 10.0f, 30.0f};
+  shen::heartbeat_stream stream;
+  realtime_windows windows(stream, periods);
+  Expect(windows.GetWindowCount() == 4 && windows.GetPeriodSec(1) == 4.0f, "one window per period");
+
+  std::mt19937_64 rng(7);
+  std::uniform_real_distribution<double> duration(450.0, 2100.0);
+  std::vector<double> durations(400);
+  for (auto& d : durations) {
+    d = duration(rng);
+  }
+  const std::vector<heartbeat> beats = Beats(1.0, durations);
+  bool matches = true;
+  for (std::size_t added = 0; added < beats.size();) {
+    // Uneven batches, as polls deliver them.
+    const std::size_t count = std::min<std::size_t>(1 + added % 5, beats.size() - added);
+    windows.Add(shen::span<const heartbeat>(beats.data() + added, count));
+    added += count;
+    const std::vector<heartbeat> seen(beats.begin(), beats.begin() + added);
+    for (std::size_t i = 0; i < periods.size(); ++i) {
+      matches = matches && Matches(windows.GetMetrics(i), Reference(seen, periods[i]));
+    }
+  }
+  Expect(matches, "the running metrics match a recomputation over each window after every batch");
+}
+
+void TestEvenBeats() {
+  shen::heartbeat_stream stream;
+  realtime_windows windows(stream, {10.0f});
+  const std::vector<heartbeat> beats = Beats(0.0, std::vector<double>(20, 1000.0));
+  windows.Add(beats);
+  const realtime_window_metrics metrics = windows.GetMetrics(0);
+  Expect(metrics.beat_count == 10, "a window holds the beats ending within its period");
+  Expect(metrics.heart_rate_bpm && std::abs(*metrics.heart_rate_bpm - 60.0) < 1e-12, "1 s beats are 60 BPM");
+  Expect(metrics.hrv_sdnn_ms == 0.0, "even beats have no deviation");
+  Expect(!metrics.hrv_lnrmssd_ms && !metrics.stress_index, "even beats have no RMSSD or stress index");
+}
+
+void TestNewMeasurementClears() {
+  shen::heartbeat_stream stream;
+  realtime_windows windows(stream, {60.0f});
+  const std::vector<heartbeat> first = Beats(100.0, std::vector<double>(30, 800.0));
+  windows.Add(first);
+  Expect(windows.GetMetrics(0).beat_count == 30, "the beats of the first measurement are kept");
+  const std::vector<heartbeat> second = Beats(0.0, {900.0, 1100.0});
+  windows.Add(second);
+  const realtime_window_metrics metrics = windows.GetMetrics(0);
+  Expect(metrics.beat_count == 2 && metrics.heart_rate_bpm == 60.0, "a beat ending earlier starts over");
+}
+
+void TestPollFollowsStream() {
+  shen::heartbeat_stream stream;
+  Expect(!stream.IsActive(), "a stream without readers is inactive");
+  {
+    realtime_windows windows(stream, {30.0f});
+    Expect(stream.IsActive(), "the windows are a reader of the stream");
+    const std::vector<heartbeat> beats = Beats(0.0, std::vector<double>(150, 750.0));
+    stream.Append(beats);
+    windows.Poll(0.0);
+    const realtime_window_metrics metrics = windows.GetMetrics(0);
+    Expect(metrics.beat_count == 40 && metrics.heart_rate_bpm == 80.0, "a poll reads the new beats of the stream");
+    windows.Poll(0.0);
+    Expect(windows.GetMetrics(0).beat_count == 40, "a poll with no new beats changes nothing");
+  }
+  Expect(!stream.IsActive(), "the stream goes inactive once the windows are destroyed");
+}
+
+}  // namespace
+
+namespace shen {
+
+std::vector<heartbeat> GetRealtimeHeartbeats(std::optional<float> /*period_sec*/) { return {}; }
+
+}  // namespace shen
+
+int main() {
+  TestMatchesRecomputation();
+  TestEvenBeats();
+  TestNewMeasurementClears();
+  TestPollFollowsStream();
+  std::printf("realtime_windows_test: %d failures\n", g_failures);
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,90 @@
+// Unit tests of seqlock: stored values are loaded back, the version counts stores, and readers racing a writer never
+// see a torn value.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "seqlock.h"
+
+namespace {
+
+int g_failures = 0;
+
+void Expect(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    ++g_failures;
+  }
+}
+
+// Spans several words, and an odd size, so that a torn copy shows as unequal fields.
+struct triple {
+  std::uint64_t a;
+  std::uint64_t b;
+  std::uint32_t c;
+};
+
+triple Make(std::uint64_t value) { return {value, ~value, static_cast<std::uint32_t>(value)}; }
+
+bool IsWhole(const triple& t) { return t.b == ~t.a && t.c == static_cast<std::uint32_t>(t.a); }
+
+void TestStoreAndLoad() {
+  shen::seqlock<triple> lock;
+  Expect(lock.Load().a == 0 && lock.Load().c == 0, "a default seqlock holds a value-initialized value");
+  Expect(lock.GetVersion() == 0, "no stores yet");
+  lock.Store(Make(42));
+  const triple loaded = lock.Load();
+  Expect(loaded.a == 42 && IsWhole(loaded), "a stored value is loaded back");
+  lock.Store(Make(43));
+  Expect(lock.GetVersion() == 2, "the version counts the stores");
+
+  const shen::seqlock<triple> initialized(Make(7));
+  Expect(initialized.Load().a == 7 && initialized.GetVersion() == 0, "the initial value is not a store");
+}
+
+void TestReadersNeverSeeTornValues() {
+  constexpr std::uint64_t kStores = 200000;
+  shen::seqlock<triple> lock(Make(0));
+  std::atomic<bool> done{false};
+  std::atomic<bool> torn{false};
+  std::atomic<bool> backwards{false};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&] {
+      std::uint64_t last = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        const triple value = lock.Load();
+        if (!IsWhole(value)) {
+          torn = true;
+        }
+        if (value.a < last) {
+          backwards = true;
+        }
+        last = value.a;
+      }
+    });
+  }
+  for (std::uint64_t i = 1; i <= kStores; ++i) {
+    lock.Store(Make(i));
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  Expect(!torn, "a reader never sees a value mixed from two stores");
+  Expect(!backwards, "a reader never sees an older value after a newer one");
+  Expect(lock.Load().a == kStores && lock.GetVersion() == kStores, "the last store wins");
+}
+
+}  // namespace
+
+int main() {
+  TestStoreAndLoad();
+  TestReadersNeverSeeTornValues();
+  std::printf("seqlock_test: %d failures\n", g_failures);
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,158 @@
+// Measures how long UI-side reads of the realtime snapshot take while the polling thread keeps publishing it: reader
+// threads poll at a fixed rate while a writer stores a new snapshot at camera frame rate, then as fast as it can. The
+// seqlock used by realtime_snapshot_publisher is compared with the same snapshot behind a mutex.
+//
+// usage: snapshot_contention_benchmark [seconds] [readers] [reader_hz]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "realtime_snapshot.h"
+#include "seqlock.h"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+class mutex_snapshot {
+ public:
+  void Store(const shen::realtime_snapshot& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    value_ = value;
+  }
+  shen::realtime_snapshot Load(std::uint32_t& /*retries*/) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return value_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  shen::realtime_snapshot value_{};
+};
+
+struct contention_result {
+  std::vector<double> read_ns;
+  std::vector<double> write_ns;
+  std::uint64_t retries = 0;
+  std::uint64_t torn = 0;
+};
+
+double Percentile(std::vector<double>& values, double q) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  const auto rank = static_cast<std::size_t>(q * static_cast<double>(values.size() - 1));
+  std::nth_element(values.begin(), values.begin() + rank, values.end());
+  return values[rank];
+}
+
+shen::realtime_snapshot MakeSnapshot(std::uint64_t sequence) {
+  shen::realtime_snapshot snapshot{};
+  snapshot.timestamp_sec = static_cast<double>(sequence) / 30.0;
+  snapshot.sequence = sequence;
+  snapshot.has_heart_rate = true;
+  // Every field derives from the sequence number, so readers can tell a torn copy.
+  snapshot.heart_rate_bpm = static_cast<int>(sequence % 1000);
+  snapshot.measurement_progress_percentage = static_cast<float>(sequence % 100);
+  return snapshot;
+}
+
+bool IsConsistent(const shen::realtime_snapshot& snapshot) {
+  return snapshot.heart_rate_bpm == static_cast<int>(snapshot.sequence % 1000) &&
+         snapshot.measurement_progress_percentage == static_cast<float>(snapshot.sequence % 100);
+}
+
+template <typename Store>
+contention_result Run(Store& store, double seconds, std::size_t reader_count, double reader_hz, double writer_hz) {
+  contention_result result;
+  std::atomic<bool> done{false};
+  std::mutex merge_mutex;
+
+  std::vector<std::thread> readers;
+  for (std::size_t r = 0; r < reader_count; ++r) {
+    readers.emplace_back([&] {
+      std::vector<double> read_ns;
+      std::uint64_t retries = 0;
+      std::uint64_t torn = 0;
+      const auto period =
+          std::chrono::duration_cast<clock_type::duration>(std::chrono::duration<double>(1.0 / reader_hz));
+      auto next = clock_type::now();
+      while (!done.load(std::memory_order_relaxed)) {
+        std::uint32_t attempt_retries = 0;
+        const auto before = clock_type::now();
+        const shen::realtime_snapshot snapshot = store.Load(attempt_retries);
+        read_ns.push_back(std::chrono::duration<double, std::nano>(clock_type::now() - before).count());
+        retries += attempt_retries;
+        torn += IsConsistent(snapshot) ? 0 : 1;
+        next += period;
+        std::this_thread::sleep_until(next);
+      }
+      std::lock_guard<std::mutex> lock(merge_mutex);
+      result.read_ns.insert(result.read_ns.end(), read_ns.begin(), read_ns.end());
+      result.retries += retries;
+      result.torn += torn;
+    });
+  }
+
+  // A writer_hz of 0 stores back to back.
+  const auto period = writer_hz > 0.0 ? std::chrono::duration_cast<clock_type::duration>(
+                                            std::chrono::duration<double>(1.0 / writer_hz))
+                                      : clock_type::duration::zero();
+  const auto end = clock_type::now() + std::chrono::duration_cast<clock_type::duration>(
+                                           std::chrono::duration<double>(seconds));
+  auto next = clock_type::now();
+  for (std::uint64_t sequence = 1; clock_type::now() < end; ++sequence) {
+    const shen::realtime_snapshot snapshot = MakeSnapshot(sequence);
+    const auto before = clock_type::now();
+    store.Store(snapshot);
+    result.write_ns.push_back(std::chrono::duration<double, std::nano>(clock_type::now() - before).count());
+    if (period != clock_type::duration::zero()) {
+      next += period;
+      std::this_thread::sleep_until(next);
+    }
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  return result;
+}
+
+void Report(const char* name, const char* writer, contention_result result) {
+  std::printf("%-8s %-10s %10zu %9.1f %9.1f %10.1f %9.1f %10.1f %9llu %6llu\n", name, writer, result.read_ns.size(),
+              Percentile(result.read_ns, 0.5), Percentile(result.read_ns, 0.99), Percentile(result.read_ns, 1.0),
+              Percentile(result.write_ns, 0.5), Percentile(result.write_ns, 1.0),
+              static_cast<unsigned long long>(result.retries), static_cast<unsigned long long>(result.torn));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const double seconds = argc > 1 ? std::strtod(argv[1], nullptr) : 2.0;
+  const std::size_t reader_count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4;
+  const double reader_hz = argc > 3 ? std::strtod(argv[3], nullptr) : 1000.0;
+
+  std::printf("seconds: %.1f, readers: %zu at %.0f Hz, snapshot: %zu bytes\n\n", seconds, reader_count, reader_hz,
+              sizeof(shen::realtime_snapshot));
+  std::printf("%-8s %-10s %10s %9s %9s %10s %9s %10s %9s %6s\n", "store", "writer", "reads", "read p50", "read p99",
+              "read max", "write p50", "write max", "retries", "torn");
+
+  for (const double writer_hz : {30.0, 0.0}) {
+    const char* writer = writer_hz > 0.0 ? "30 Hz" : "saturated";
+    {
+      shen::seqlock<shen::realtime_snapshot> store;
+      Report("seqlock", writer, Run(store, seconds, reader_count, reader_hz, writer_hz));
+    }
+    {
+      mutex_snapshot store;
+      Report("mutex", writer, Run(store, seconds, reader_count, reader_hz, writer_hz));
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,94 @@
+// Unit tests of spsc_ring: capacity rounding, full and empty queues, FIFO order across the wrap-around, and no lost or
+// reordered elements with a concurrent producer and consumer.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "spsc_ring.h"
+
+namespace {
+
+int g_failures = 0;
+
+void Expect(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    ++g_failures;
+  }
+}
+
+void TestFullAndEmpty() {
+  shen::spsc_ring<int> ring(5);
+  Expect(ring.GetCapacity() == 8, "the capacity is rounded up to a power of two");
+  int value = 0;
+  Expect(!ring.TryPop(value), "a new queue is empty");
+  for (int i = 0; i < 8; ++i) {
+    Expect(ring.TryPush(i), "pushes succeed up to the capacity");
+  }
+  Expect(!ring.TryPush(8), "a push to a full queue fails");
+  Expect(ring.GetSize() == 8, "the size counts the queued elements");
+  Expect(ring.TryPop(value) && value == 0, "the oldest element is popped first");
+  Expect(ring.TryPush(8), "a pop makes room for a push");
+}
+
+void TestOrderAcrossWrapAround() {
+  shen::spsc_ring<int> ring(4);
+  int next_push = 0;
+  int next_pop = 0;
+  bool in_order = true;
+  std::vector<int> out(3);
+  for (int round = 0; round < 10; ++round) {
+    while (ring.TryPush(next_push)) {
+      ++next_push;
+    }
+    const std::size_t count = ring.Pop(shen::span<int>(out.data(), out.size()));
+    for (std::size_t i = 0; i < count; ++i) {
+      in_order = in_order && out[i] == next_pop++;
+    }
+  }
+  Expect(in_order, "elements are popped in push order across the wrap-around");
+  Expect(ring.GetSize() == static_cast<std::size_t>(next_push - next_pop), "the size matches pushes minus pops");
+  Expect(ring.Pop(shen::span<int>(out.data(), out.size())) == 1, "Pop copies only the queued elements");
+}
+
+void TestConcurrentProducerAndConsumer() {
+  constexpr std::uint64_t kCount = 1000000;
+  shen::spsc_ring<std::uint64_t> ring(64);
+  std::thread producer([&] {
+    for (std::uint64_t i = 0; i < kCount;) {
+      if (ring.TryPush(i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::uint64_t expected = 0;
+  bool in_order = true;
+  std::vector<std::uint64_t> out(16);
+  while (expected < kCount) {
+    const std::size_t count = ring.Pop(shen::span<std::uint64_t>(out.data(), out.size()));
+    for (std::size_t i = 0; i < count; ++i) {
+      in_order = in_order && out[i] == expected++;
+    }
+    if (count == 0) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  Expect(in_order, "a concurrent consumer sees every element once, in order");
+  Expect(ring.GetSize() == 0, "the queue is drained");
+}
+
+}  // namespace
+
+int main() {
+  TestFullAndEmpty();
+  TestOrderAcrossWrapAround();
+  TestConcurrentProducerAndConsumer();
+  std::printf("spsc_ring_test: %d failures\n", g_failures);
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
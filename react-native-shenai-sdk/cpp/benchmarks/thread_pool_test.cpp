@@ -0,0 +1,131 @@
+// Unit tests of thread_pool: every index is visited exactly once, small ranges run on the calling thread, exceptions
+// reach the caller, and a nested ParallelFor on the same pool throws instead of deadlocking.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "thread_pool.h"
+
+namespace {
+
+int g_failures = 0;
+
+void Expect(bool condition, const char* what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what);
+    ++g_failures;
+  }
+}
+
+void TestEveryIndexOnce() {
+  shen::thread_pool pool(4);
+  Expect(pool.GetThreadCount() == 4, "the thread count includes the calling thread");
+  constexpr std::size_t kCount = 10007;
+  std::vector<std::atomic<int>> visits(kCount);
+  std::atomic<bool> bad_chunk{false};
+  pool.ParallelFor(kCount, 7, [&](std::size_t begin, std::size_t end) {
+    if (begin >= end || end - begin > 7 || end > kCount) {
+      bad_chunk = true;
+    }
+    for (std::size_t i = begin; i < end; ++i) {
+      visits[i].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+  Expect(!bad_chunk, "chunks are non-empty, within the range and at most grain_size long");
+  bool once = true;
+  for (const auto& v : visits) {
+    once = once && v.load() == 1;
+  }
+  Expect(once, "every index is visited exactly once");
+}
+
+void TestSmallRangesRunInline() {
+  shen::thread_pool pool(4);
+  const std::thread::id caller = std::this_thread::get_id();
+  int calls = 0;
+  bool on_caller = false;
+  pool.ParallelFor(10, 64, [&](std::size_t begin, std::size_t end) {
+    ++calls;
+    on_caller = std::this_thread::get_id() == caller && begin == 0 && end == 10;
+  });
+  Expect(calls == 1 && on_caller, "a range within one grain runs as one chunk on the calling thread");
+  pool.ParallelFor(0, 1, [&](std::size_t, std::size_t) { ++calls; });
+  Expect(calls == 1, "an empty range runs nothing");
+
+  shen::thread_pool single(1);
+  bool all_on_caller = true;
+  single.ParallelFor(1000, 1, [&](std::size_t, std::size_t) {
+    all_on_caller = all_on_caller && std::this_thread::get_id() == caller;
+  });
+  Expect(all_on_caller, "a one-thread pool runs everything on the calling thread");
+}
+
+void TestExceptionReachesCaller() {
+  shen::thread_pool pool(4);
+  bool caught = false;
+  try {
+    pool.ParallelFor(1000, 1, [](std::size_t begin, std::size_t) {
+      if (begin == 500) {
+        throw std::runtime_error("chunk failed");
+      }
+    });
+  } catch (const std::runtime_error&) {
+    caught = true;
+  }
+  Expect(caught, "an exception thrown by a chunk is rethrown on the calling thread");
+
+  std::atomic<std::size_t> visited{0};
+  pool.ParallelFor(1000, 10, [&](std::size_t begin, std::size_t end) { visited += end - begin; });
+  Expect(visited == 1000, "the pool is usable after a failed ParallelFor");
+}
+
+void TestNestedCallThrows() {
+  shen::thread_pool pool(4);
+  std::atomic<bool> running_flag_set{true};
+  std::atomic<int> nested_throws{0};
+  pool.ParallelFor(64, 1, [&](std::size_t, std::size_t) {
+    if (!pool.IsRunningOnCurrentThread()) {
+      running_flag_set = false;
+    }
+    try {
+      pool.ParallelFor(100, 1, [](std::size_t, std::size_t) {});
+    } catch (const std::logic_error&) {
+      ++nested_throws;
+    }
+  });
+  Expect(running_flag_set, "IsRunningOnCurrentThread holds inside every chunk");
+  Expect(nested_throws == 64, "a nested ParallelFor on the same pool throws on every thread");
+  Expect(!pool.IsRunningOnCurrentThread(), "IsRunningOnCurrentThread is false outside a ParallelFor");
+
+  bool caught = false;
+  try {
+    pool.ParallelFor(64, 1, [&](std::size_t, std::size_t) {
+      pool.ParallelFor(100, 1, [](std::size_t, std::size_t) {});
+    });
+  } catch (const std::logic_error&) {
+    caught = true;
+  }
+  Expect(caught, "an uncaught nested ParallelFor ends the outer one with std::logic_error");
+
+  shen::thread_pool other(2);
+  std::atomic<std::size_t> visited{0};
+  pool.ParallelFor(8, 1, [&](std::size_t, std::size_t) {
+    other.ParallelFor(4, 1, [&](std::size_t begin, std::size_t end) { visited += end - begin; });
+  });
+  Expect(visited == 32, "a ParallelFor on another pool may run inside a chunk");
+}
+
+}  // namespace
+
+int main() {
+  TestEveryIndexOnce();
+  TestSmallRangesRunInline();
+  TestExceptionReachesCaller();
+  TestNestedCallThrows();
+  std::printf("thread_pool_test: %d failures\n", g_failures);
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
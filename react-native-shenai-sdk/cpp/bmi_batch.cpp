@@ -0,0 +1,47 @@
+#include "bmi_batch.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace shen {
+
+namespace {
+
+// Number of thresholds reached by `value`, unrolled over the constant thresholds. Counting in double keeps every lane
+// the width of the input, which lets the compare-and-select vectorize.
+template <std::size_t... I>
+double CountReachedThresholds(double value, std::index_sequence<I...>) {
+  return ((value >= kBmiCategoryLowerBounds[I] ? 1.0 : 0.0) + ...);
+}
+
+}  // namespace
+
+std::size_t ClassifyBmi(span<const double> bmi, span<mx::BmiCategory> categories, span<std::uint8_t> valid) {
+  constexpr double kInfinity = std::numeric_limits<double>::infinity();
+  const std::size_t count = std::min({bmi.size(), categories.size(), valid.size()});
+  const double* values = bmi.data();
+  mx::BmiCategory* out = categories.data();
+  std::uint8_t* out_valid = valid.data();
+  for (std::size_t i = 0; i < count; ++i) {
+    const double value = values[i];
+    const double category = CountReachedThresholds(value, std::make_index_sequence<kBmiCategoryLowerBounds.size()>());
+    out[i] = static_cast<mx::BmiCategory>(static_cast<int>(category));
+    // Both comparisons are false for NaN; non-short-circuit & keeps the select free of branches.
+    out_valid[i] = static_cast<std::uint8_t>((value >= 0.0) & (value < kInfinity));
+  }
+  return count;
+}
+
+std::size_t AdjustBmiWeightHeight(span<double> bmi, span<double> weight, span<double> height,
+                                  bool round_weight_height, thread_pool& pool, std::size_t grain_size) {
+  const std::size_t count = std::min({bmi.size(), weight.size(), height.size()});
+  pool.ParallelFor(count, grain_size, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      mx::adjustBmiWeightHeight(bmi[i], weight[i], height[i], round_weight_height);
+    }
+  });
+  return count;
+}
+
+}  // namespace shen
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "span.h"
+#include "thread_pool.h"
+
+namespace shen {
+
+/**
+ * Default number of records handed to a worker thread at a time by the batch AdjustBmiWeightHeight.
+ */
+constexpr std::size_t kDefaultBmiBatchGrainSize = 4096;
+
+/**
+ * Lower bounds of the BMI categories above UnderweightSevere, in category order. A copy of the bounds in
+ * mx::kBmiRanges, which is not constexpr; consistency_check verifies that the two agree.
+ */
+constexpr std::array<double, 7> kBmiCategoryLowerBounds = {16.0, 17.0, 18.5, 25.0, 30.0, 35.0, 40.0};
+
+/**
+ * Classifies a batch of BMI values: `categories[i]` gets the category of `bmi[i]`, and `valid[i]` is 1 if it has one.
+ * As with the scalar mx::classifyBmi, negative, NaN and infinite values have no category; `valid[i]` is then 0 and
+ * `categories[i]` unspecified.
+ * The category is the number of kBmiCategoryLowerBounds the value reaches. Both outputs are computed without branches,
+ * so the loop vectorizes on targets that convert doubles to bytes in vector registers, such as AArch64, or x86-64 with
+ * AVX2; for baseline x86-64, GCC 12 keeps it scalar.
+ * @return The number of values classified: the smallest of the three span sizes.
+ */
+std::size_t ClassifyBmi(span<const double> bmi, span<mx::BmiCategory> categories, span<std::uint8_t> valid);
+
+/**
+ * Adjusts a batch of records stored as columns, in place; record i is (`bmi[i]`, `weight[i]`, `height[i]`).
+ * Each record goes through the scalar mx::adjustBmiWeightHeight, so the results are bit-identical to a scalar loop;
+ * records are distributed across `pool` in chunks of `grain_size`.
+ * @return The number of records adjusted: the smallest of the three span sizes.
+ */
+std::size_t AdjustBmiWeightHeight(span<double> bmi, span<double> weight, span<double> height,
+                                  bool round_weight_height = false, thread_pool& pool = DefaultThreadPool(),
+                                  std::size_t grain_size = kDefaultBmiBatchGrainSize);
+
+}  // namespace shen
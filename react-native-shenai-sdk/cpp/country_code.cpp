@@ -0,0 +1,20 @@
+#include "country_code.h"
+
+namespace shen {
+
+void country_code::AssignTo(std::string& out) const {
+  if (IsEmpty()) {
+    out.clear();
+    return;
+  }
+  const char letters[2] = {static_cast<char>(value_ >> 8), static_cast<char>(value_ & 0xff)};
+  out.assign(letters, 2);
+}
+
+std::string country_code::ToString() const {
+  std::string out;
+  AssignTo(out);
+  return out;
+}
+
+}  // namespace shen
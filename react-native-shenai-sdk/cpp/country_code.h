@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace shen {
+
+/**
+ * RisksFactors::country value of two ASCII letters, such as an ISO 3166-1 alpha-2 code, packed into 16 bits: the
+ * letters as given, first letter in the high byte. The value 0 stands for "no country" (an empty
+ * RisksFactors::country). The letters are not case-folded, so every representable string converts back unchanged.
+ */
+class country_code {
+ public:
+  constexpr country_code() = default;
+
+  /**
+   * Parses a RisksFactors::country value.
+   * @return An empty code for an empty string, the code of a string of two ASCII letters, or std::nullopt for any
+   * other string, which has no country_code representation.
+   */
+  static constexpr std::optional<country_code> FromString(std::string_view code) {
+    if (code.empty()) {
+      return country_code();
+    }
+    if (code.size() != 2 || !IsLetter(code[0]) || !IsLetter(code[1])) {
+      return std::nullopt;
+    }
+    return country_code(static_cast<std::uint16_t>((code[0] << 8) | code[1]));
+  }
+
+  constexpr std::uint16_t GetValue() const { return value_; }
+  constexpr bool IsEmpty() const { return value_ == 0; }
+
+  /**
+   * Writes the code into `out` (empty for an empty code). Two letters fit in the small-string buffer of
+   * std::string, so this never allocates.
+   */
+  void AssignTo(std::string& out) const;
+
+  std::string ToString() const;
+
+  friend constexpr bool operator==(country_code a, country_code b) { return a.value_ == b.value_; }
+  friend constexpr bool operator!=(country_code a, country_code b) { return a.value_ != b.value_; }
+
+ private:
+  constexpr explicit country_code(std::uint16_t value) : value_(value) {}
+
+  static constexpr bool IsLetter(char c) { return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'); }
+
+  std::uint16_t value_{0};
+};
+
+}  // namespace shen
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "span.h"
+
+namespace shen {
+
+/**
+ * Fixed-capacity history of items numbered sequentially from 0, read incrementally by any number of readers.
+ * Each reader keeps a cursor, the sequence number of the next item to read, and copies only the items pushed after it.
+ * Once full, each push evicts the oldest item. Not synchronized: the owner guards all calls with its own lock.
+ */
+template <typename T>
+class cursor_ring {
+ public:
+  /**
+   * Creates the ring.
+   * @param capacity The number of most recent items kept, at least 1.
+   */
+  explicit cursor_ring(std::size_t capacity) : items_(std::max<std::size_t>(capacity, 1)) {}
+
+  void Push(const T& item) {
+    items_[end_ % items_.size()] = item;
+    ++end_;
+  }
+
+  /**
+   * Copies the items pushed after `cursor` into `out`, oldest first, and advances `cursor` past them. If items after
+   * `cursor` were already evicted, reading resumes at the oldest item still kept.
+   * @return The number of items copied, at most `out.size()`.
+   */
+  std::size_t Read(std::uint64_t& cursor, span<T> out) const {
+    const std::uint64_t oldest = end_ > items_.size() ? end_ - items_.size() : 0;
+    cursor = std::clamp(cursor, oldest, end_);
+    const auto count = static_cast<std::size_t>(std::min<std::uint64_t>(end_ - cursor, out.size()));
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = items_[(cursor + i) % items_.size()];
+    }
+    cursor += count;
+    return count;
+  }
+
+  /**
+   * Gets the cursor just past the newest item.
+   */
+  std::uint64_t GetEnd() const { return end_; }
+
+ private:
+  std::vector<T> items_;  // indexed by sequence number % capacity
+  std::uint64_t end_{0};
+};
+
+}  // namespace shen
@@ -0,0 +1,37 @@
+#include "health_index.h"
+
+namespace shen {
+
+health_index_mask ToHealthIndexMask(const std::vector<HealthIndex>& indices) {
+  health_index_mask mask = 0;
+  for (HealthIndex index : indices) {
+    mask |= HealthIndexBit(index);
+  }
+  return mask;
+}
+
+void CopyHealthIndices(const mx::health_risks::HealthRisks& from, mx::health_risks::HealthRisks& to,
+                       health_index_mask indices) {
+  auto has = [indices](HealthIndex index) { return (indices & HealthIndexBit(index)) != 0; };
+  if (has(HealthIndex::WellnessScore)) to.wellness_score = from.wellness_score;
+  if (has(HealthIndex::VascularAge)) to.vascular_age = from.vascular_age;
+  if (has(HealthIndex::CardiovascularDiseaseRisk)) to.cv_diseases = from.cv_diseases;
+  if (has(HealthIndex::HardAndFatalEventsRisks)) to.hard_and_fatal_events = from.hard_and_fatal_events;
+  if (has(HealthIndex::CardiovascularRiskScore)) to.scores = from.scores;
+  if (has(HealthIndex::WaistToHeightRatio)) to.waist_to_height_ratio = from.waist_to_height_ratio;
+  if (has(HealthIndex::BodyFatPercentage)) to.body_fat_percentage = from.body_fat_percentage;
+  if (has(HealthIndex::BodyRoundnessIndex)) to.body_roundness_index = from.body_roundness_index;
+  if (has(HealthIndex::ABodyShapeIndex)) to.a_body_shape_index = from.a_body_shape_index;
+  if (has(HealthIndex::ConicityIndex)) to.conicity_index = from.conicity_index;
+  if (has(HealthIndex::BasalMetabolicRate)) to.basal_metabolic_rate = from.basal_metabolic_rate;
+  if (has(HealthIndex::TotalDailyEnergyExpenditure)) {
+    to.total_daily_energy_expenditure = from.total_daily_energy_expenditure;
+  }
+  if (has(HealthIndex::HypertensionRisk)) to.hypertension_risk = from.hypertension_risk;
+  if (has(HealthIndex::DiabetesRisk)) to.diabetes_risk = from.diabetes_risk;
+  if (has(HealthIndex::NonAlcoholicFattyLiverDiseaseRisk)) {
+    to.non_alcoholic_fatty_liver_disease_risk = from.non_alcoholic_fatty_liver_disease_risk;
+  }
+}
+
+}  // namespace shen
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace shen {
+
+constexpr std::size_t kHealthIndexCount = static_cast<std::size_t>(HealthIndex::NonAlcoholicFattyLiverDiseaseRisk) + 1;
+
+/**
+ * Set of health indices, one bit per HealthIndex.
+ */
+using health_index_mask = std::uint16_t;
+
+constexpr health_index_mask HealthIndexBit(HealthIndex index) {
+  return static_cast<health_index_mask>(1u << static_cast<int>(index));
+}
+
+constexpr health_index_mask kAllHealthIndices = static_cast<health_index_mask>((1u << kHealthIndexCount) - 1);
+
+/**
+ * Converts a list of health indices (as used by custom_measurement_config::health_indices) into a mask.
+ */
+health_index_mask ToHealthIndexMask(const std::vector<HealthIndex>& indices);
+
+/**
+ * Copies the HealthRisks fields holding the indices in `indices` from `from` to `to`.
+ * This only filters a result: the SDK evaluates every model in each ComputeHealthRisks call, so restricting the
+ * output saves no computation.
+ */
+void CopyHealthIndices(const mx::health_risks::HealthRisks& from, mx::health_risks::HealthRisks& to,
+                       health_index_mask indices);
+
+}  // namespace shen
@@ -0,0 +1,19 @@
+#include "health_risks_batch.h"
+
+#include <algorithm>
+
+namespace shen {
+
+std::size_t ComputeHealthRisks(span<const mx::health_risks::RisksFactors> risk_factors,
+                               span<mx::health_risks::HealthRisks> health_risks, thread_pool& pool,
+                               std::size_t grain_size) {
+  const std::size_t count = std::min(risk_factors.size(), health_risks.size());
+  pool.ParallelFor(count, grain_size, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      health_risks[i] = ComputeHealthRisks(risk_factors[i]);
+    }
+  });
+  return count;
+}
+
+}  // namespace shen
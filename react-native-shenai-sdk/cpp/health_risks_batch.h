@@ -0,0 +1,32 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <cstddef>
+
+#include "span.h"
+#include "thread_pool.h"
+
+namespace shen {
+
+/**
+ * Default number of records handed to a worker thread at a time by the batch entry points.
+ */
+constexpr std::size_t kDefaultRiskBatchGrainSize = 64;
+
+/**
+ * Computes the health risks for a batch of risk factors, e.g. a whole clinic roster.
+ * The result for `risk_factors[i]` is written to `health_risks[i]`. Records are distributed across `pool` in chunks of
+ * `grain_size` records; each record is evaluated with ComputeHealthRisks(const RisksFactors&).
+ * @param risk_factors The risk factors of each record.
+ * @param health_risks Caller-provided output range, at least as long as `risk_factors`.
+ * @param pool The thread pool to run on.
+ * @param grain_size The number of records handed to a thread at a time.
+ * @return The number of records computed: the smaller of the two range sizes.
+ */
+std::size_t ComputeHealthRisks(span<const mx::health_risks::RisksFactors> risk_factors,
+                               span<mx::health_risks::HealthRisks> health_risks,
+                               thread_pool& pool = DefaultThreadPool(),
+                               std::size_t grain_size = kDefaultRiskBatchGrainSize);
+
+}  // namespace shen
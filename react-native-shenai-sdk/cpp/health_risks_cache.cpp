@@ -0,0 +1,107 @@
+#include "health_risks_cache.h"
+
+#include <cassert>
+
+#include "risks_factors_hash.h"
+
+namespace shen {
+
+health_risks_cache::health_risks_cache(std::size_t capacity) : capacity_(capacity) {}
+
+bool health_risks_cache::key_equal::operator()(const key& a, const key& b) const {
+  // An entry's own key always matches, whatever the factors hold, so eviction can erase by key.
+  return a.query == b.query && a.hash == b.hash &&
+         (a.risk_factors == b.risk_factors || RisksFactorsEqual(*a.risk_factors, *b.risk_factors));
+}
+
+mx::health_risks::HealthRisks health_risks_cache::ComputeHealthRisks(
+    const mx::health_risks::RisksFactors& risk_factors) {
+  return Lookup(Query::Actual, risk_factors);
+}
+
+mx::health_risks::HealthRisks health_risks_cache::GetMaximalRisks(const mx::health_risks::RisksFactors& risk_factors) {
+  return Lookup(Query::Maximal, risk_factors);
+}
+
+mx::health_risks::HealthRisks health_risks_cache::GetMinimalRisks(const mx::health_risks::RisksFactors& risk_factors) {
+  return Lookup(Query::Minimal, risk_factors);
+}
+
+mx::health_risks::HealthRisks health_risks_cache::GetReferenceRisks(
+    const mx::health_risks::RisksFactors& risk_factors) {
+  return Lookup(Query::Reference, risk_factors);
+}
+
+mx::health_risks::HealthRisks health_risks_cache::Lookup(Query query,
+                                                         const mx::health_risks::RisksFactors& risk_factors) {
+  const key probe{query, HashRisksFactors(risk_factors), &risk_factors};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(probe);
+    if (it != index_.end()) {
+      ++hits_;
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return it->second->health_risks;
+    }
+    ++misses_;
+  }
+
+  mx::health_risks::HealthRisks health_risks;
+  switch (query) {
+    case Query::Actual:
+      health_risks = shen::ComputeHealthRisks(risk_factors);
+      break;
+    case Query::Maximal:
+      health_risks = shen::GetMaximalRisks(risk_factors);
+      break;
+    case Query::Minimal:
+      health_risks = shen::GetMinimalRisks(risk_factors);
+      break;
+    case Query::Reference:
+      health_risks = shen::GetReferenceRisks(risk_factors);
+      break;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (capacity_ == 0 || index_.count(probe) != 0) {
+    return health_risks;
+  }
+  lru_.push_front(entry{query, probe.hash, risk_factors, health_risks});
+  index_.emplace(key{query, probe.hash, &lru_.front().risk_factors}, lru_.begin());
+  EvictToCapacity();
+  return health_risks;
+}
+
+void health_risks_cache::EvictToCapacity() {
+  while (lru_.size() > capacity_) {
+    const entry& last = lru_.back();
+    [[maybe_unused]] const std::size_t erased = index_.erase(key{last.query, last.hash, &last.risk_factors});
+    assert(erased == 1);
+    lru_.pop_back();
+  }
+}
+
+void health_risks_cache::SetCapacity(std::size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  EvictToCapacity();
+}
+
+health_risks_cache_stats health_risks_cache::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {hits_, misses_, lru_.size(), capacity_};
+}
+
+void health_risks_cache::ResetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  hits_ = 0;
+  misses_ = 0;
+}
+
+void health_risks_cache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  index_.clear();
+  lru_.clear();
+}
+
+}  // namespace shen
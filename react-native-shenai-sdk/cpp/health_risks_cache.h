@@ -0,0 +1,118 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace shen {
+
+/**
+ * Statistics of a health_risks_cache.
+ */
+struct health_risks_cache_stats {
+  std::uint64_t hits;
+  std::uint64_t misses;
+  std::size_t size;
+  std::size_t capacity;
+};
+
+/**
+ * Bounded, thread-safe LRU memoization in front of ComputeHealthRisks, GetMaximalRisks, GetMinimalRisks and
+ * GetReferenceRisks.
+ * Results are keyed on the entry point and the full set of risk factors, so repeated what-if queries for a factor set
+ * that was evaluated recently cost a hash lookup instead of a model evaluation. Models are evaluated outside of the
+ * cache lock, so concurrent misses do not serialize on each other.
+ */
+class health_risks_cache {
+ public:
+  static constexpr std::size_t kDefaultCapacity = 1024;
+
+  /**
+   * Creates the cache.
+   * @param capacity The maximum number of memoized results; 0 disables memoization.
+   */
+  explicit health_risks_cache(std::size_t capacity = kDefaultCapacity);
+
+  health_risks_cache(const health_risks_cache&) = delete;
+  health_risks_cache& operator=(const health_risks_cache&) = delete;
+
+  /**
+   * Memoized ComputeHealthRisks.
+   */
+  mx::health_risks::HealthRisks ComputeHealthRisks(const mx::health_risks::RisksFactors& risk_factors);
+
+  /**
+   * Memoized GetMaximalRisks.
+   */
+  mx::health_risks::HealthRisks GetMaximalRisks(const mx::health_risks::RisksFactors& risk_factors);
+
+  /**
+   * Memoized GetMinimalRisks.
+   */
+  mx::health_risks::HealthRisks GetMinimalRisks(const mx::health_risks::RisksFactors& risk_factors);
+
+  /**
+   * Memoized GetReferenceRisks.
+   */
+  mx::health_risks::HealthRisks GetReferenceRisks(const mx::health_risks::RisksFactors& risk_factors);
+
+  /**
+   * Sets the maximum number of memoized results, evicting the least recently used ones if needed.
+   * @param capacity The maximum number of memoized results; 0 disables memoization.
+   */
+  void SetCapacity(std::size_t capacity);
+
+  /**
+   * Gets the hit/miss counters, the current number of memoized results and the capacity.
+   */
+  health_risks_cache_stats GetStats() const;
+
+  /**
+   * Resets the hit/miss counters.
+   */
+  void ResetStats();
+
+  /**
+   * Drops all memoized results.
+   */
+  void Clear();
+
+ private:
+  enum class Query : std::uint8_t { Actual, Maximal, Minimal, Reference };
+
+  struct entry {
+    Query query;
+    std::size_t hash;
+    mx::health_risks::RisksFactors risk_factors;
+    mx::health_risks::HealthRisks health_risks;
+  };
+
+  // Lookup key pointing either at a caller's factors (probe) or at the factors owned by a list entry.
+  struct key {
+    Query query;
+    std::size_t hash;
+    const mx::health_risks::RisksFactors* risk_factors;
+  };
+  struct key_hash {
+    std::size_t operator()(const key& k) const { return k.hash; }
+  };
+  struct key_equal {
+    bool operator()(const key& a, const key& b) const;
+  };
+
+  mx::health_risks::HealthRisks Lookup(Query query, const mx::health_risks::RisksFactors& risk_factors);
+  void EvictToCapacity();
+
+  mutable std::mutex mutex_;
+  std::size_t capacity_;
+  std::list<entry> lru_;  // most recently used first
+  std::unordered_map<key, std::list<entry>::iterator, key_hash, key_equal> index_;
+  std::uint64_t hits_{0};
+  std::uint64_t misses_{0};
+};
+
+}  // namespace shen
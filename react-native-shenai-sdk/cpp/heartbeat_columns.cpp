@@ -0,0 +1,84 @@
+#include "heartbeat_columns.h"
+
+#include <algorithm>
+#include <array>
+
+namespace shen {
+
+namespace {
+
+template <typename T>
+void Append(span<const heartbeat> beats, basic_heartbeat_columns<T>& columns) {
+  const std::size_t begin = columns.size;
+  const std::size_t n = begin + beats.size();
+  columns.start_location_sec.resize(n);
+  columns.end_location_sec.resize(n);
+  columns.duration_ms.resize(n);
+  // One pass per column keeps each store loop contiguous.
+  for (std::size_t i = 0; i < beats.size(); ++i) {
+    columns.start_location_sec[begin + i] = static_cast<T>(beats[i].start_location_sec);
+  }
+  for (std::size_t i = 0; i < beats.size(); ++i) {
+    columns.end_location_sec[begin + i] = static_cast<T>(beats[i].end_location_sec);
+  }
+  for (std::size_t i = 0; i < beats.size(); ++i) {
+    columns.duration_ms[begin + i] = static_cast<T>(beats[i].duration_ms);
+  }
+  columns.size = n;
+}
+
+template <typename T>
+std::size_t Read(const heartbeat_stream& stream, heartbeat_cursor& cursor, basic_heartbeat_columns<T>& columns) {
+  constexpr std::size_t kBatchSize = 64;
+  std::array<heartbeat, kBatchSize> batch;
+  std::size_t total = 0;
+  std::size_t count;
+  while ((count = stream.Read(cursor, batch)) != 0) {
+    Append(span<const heartbeat>(batch.data(), count), columns);
+    total += count;
+  }
+  return total;
+}
+
+template <typename T>
+std::size_t Durations(span<const heartbeat> beats, span<T> durations_ms) {
+  const std::size_t count = std::min(beats.size(), durations_ms.size());
+  for (std::size_t i = 0; i < count; ++i) {
+    durations_ms[i] = static_cast<T>(beats[i].duration_ms);
+  }
+  return count;
+}
+
+}  // namespace
+
+void ToColumns(span<const heartbeat> beats, heartbeat_columns& columns) {
+  columns.clear();
+  Append(beats, columns);
+}
+
+void ToColumns(span<const heartbeat> beats, heartbeat_columns_f32& columns) {
+  columns.clear();
+  Append(beats, columns);
+}
+
+void AppendColumns(span<const heartbeat> beats, heartbeat_columns& columns) { Append(beats, columns); }
+
+void AppendColumns(span<const heartbeat> beats, heartbeat_columns_f32& columns) { Append(beats, columns); }
+
+std::size_t ReadColumns(const heartbeat_stream& stream, heartbeat_cursor& cursor, heartbeat_columns& columns) {
+  return Read(stream, cursor, columns);
+}
+
+std::size_t ReadColumns(const heartbeat_stream& stream, heartbeat_cursor& cursor, heartbeat_columns_f32& columns) {
+  return Read(stream, cursor, columns);
+}
+
+std::size_t GetDurations(span<const heartbeat> beats, span<double> durations_ms) {
+  return Durations(beats, durations_ms);
+}
+
+std::size_t GetDurations(span<const heartbeat> beats, span<float> durations_ms) {
+  return Durations(beats, durations_ms);
+}
+
+}  // namespace shen
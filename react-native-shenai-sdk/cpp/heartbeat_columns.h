@@ -0,0 +1,73 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "heartbeat_stream.h"
+#include "span.h"
+
+namespace shen {
+
+/**
+ * Columnar (structure-of-arrays) storage of heartbeats: each field of heartbeat in its own contiguous array, indexed
+ * by beat, so that RR-interval analytics can loop over `duration_ms` alone. `T` is double, or float to halve the
+ * memory of long sessions; single precision keeps the 1 ms resolution of the SDK for locations up to about 4.5 hours.
+ */
+template <typename T>
+struct basic_heartbeat_columns {
+  std::size_t size{0};
+
+  std::vector<T> start_location_sec;
+  std::vector<T> end_location_sec;
+  std::vector<T> duration_ms;
+
+  void clear() {
+    size = 0;
+    start_location_sec.clear();
+    end_location_sec.clear();
+    duration_ms.clear();
+  }
+};
+
+using heartbeat_columns = basic_heartbeat_columns<double>;
+using heartbeat_columns_f32 = basic_heartbeat_columns<float>;
+
+/**
+ * Converts a range of heartbeats, e.g. measurement_results::heartbeats or the result of GetRealtimeHeartbeats, into
+ * columnar form, reusing the buffers already allocated by `columns`.
+ */
+void ToColumns(span<const heartbeat> beats, heartbeat_columns& columns);
+void ToColumns(span<const heartbeat> beats, heartbeat_columns_f32& columns);
+
+/**
+ * Appends a range of heartbeats to `columns`.
+ */
+void AppendColumns(span<const heartbeat> beats, heartbeat_columns& columns);
+void AppendColumns(span<const heartbeat> beats, heartbeat_columns_f32& columns);
+
+/**
+ * Appends the beats of `stream` detected after `cursor` to `columns`, and advances `cursor` past them; see
+ * heartbeat_stream::Read.
+ * @return The number of beats appended.
+ */
+std::size_t ReadColumns(const heartbeat_stream& stream, heartbeat_cursor& cursor, heartbeat_columns& columns);
+std::size_t ReadColumns(const heartbeat_stream& stream, heartbeat_cursor& cursor, heartbeat_columns_f32& columns);
+
+/**
+ * Copies the durations of a range of heartbeats into `durations_ms`.
+ * @return The number of durations copied: the smaller of `beats.size()` and `durations_ms.size()`.
+ */
+std::size_t GetDurations(span<const heartbeat> beats, span<double> durations_ms);
+std::size_t GetDurations(span<const heartbeat> beats, span<float> durations_ms);
+
+/**
+ * Reads beat `i` of `columns` back into a heartbeat.
+ */
+template <typename T>
+heartbeat GetRow(const basic_heartbeat_columns<T>& columns, std::size_t i) {
+  return {columns.start_location_sec[i], columns.end_location_sec[i], columns.duration_ms[i]};
+}
+
+}  // namespace shen
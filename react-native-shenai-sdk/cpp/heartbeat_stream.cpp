@@ -0,0 +1,48 @@
+#include "heartbeat_stream.h"
+
+#include <algorithm>
+
+namespace shen {
+
+heartbeat_stream::heartbeat_stream(std::size_t capacity, float poll_period_sec)
+    : poll_period_sec_(poll_period_sec), beats_(capacity) {}
+
+void heartbeat_stream::Poll(double /*timestamp_sec*/) {
+  const std::vector<heartbeat> window = GetRealtimeHeartbeats(poll_period_sec_);
+  Append(window);
+}
+
+std::size_t heartbeat_stream::Append(span<const heartbeat> beats) {
+  if (beats.empty()) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::size_t first = 0;
+  if (beats_.GetEnd() != 0 && beats[beats.size() - 1].start_location_sec >= last_start_sec_ - kSameBeatToleranceSec) {
+    first = static_cast<std::size_t>(
+        std::upper_bound(beats.begin(), beats.end(), last_start_sec_ + kSameBeatToleranceSec,
+                         [](double start, const heartbeat& beat) { return start < beat.start_location_sec; }) -
+        beats.begin());
+    if (first == 0 && beats[0].start_location_sec > last_end_sec_ + kSameBeatToleranceSec) {
+      gaps_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  for (std::size_t i = first; i < beats.size(); ++i) {
+    beats_.Push(beats[i]);
+  }
+  last_start_sec_ = beats[beats.size() - 1].start_location_sec;
+  last_end_sec_ = beats[beats.size() - 1].end_location_sec;
+  return beats.size() - first;
+}
+
+std::size_t heartbeat_stream::Read(heartbeat_cursor& cursor, span<heartbeat> out) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return beats_.Read(cursor, out);
+}
+
+heartbeat_cursor heartbeat_stream::GetEnd() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return beats_.GetEnd();
+}
+
+}  // namespace shen
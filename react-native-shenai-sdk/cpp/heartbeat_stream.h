@@ -0,0 +1,103 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "cursor_ring.h"
+#include "realtime_poller.h"
+#include "span.h"
+
+namespace shen {
+
+/**
+ * Position of a reader in a heartbeat_stream: the sequence number of the next heartbeat to read. Start from 0.
+ */
+using heartbeat_cursor = std::uint64_t;
+
+/**
+ * Incremental view of the heartbeats detected in realtime.
+ * Registered with a realtime_poller, it reads only the last few seconds of GetRealtimeHeartbeats on each poll and
+ * appends the beats it has not seen yet to a fixed-capacity history, numbering them sequentially. Readers keep a
+ * heartbeat_cursor and get only the beats detected after it, so the cost of a read is proportional to the number of
+ * new beats rather than to the length of the session.
+ *
+ * Beats are matched across polls by start location, within kSameBeatToleranceSec, since the SDK may refine the
+ * location of a beat between polls. If a poll comes too late for its window to overlap the beats already appended,
+ * the beats in between are lost; such gaps are counted.
+ *
+ * The stream is only polled while it has readers: a reader calls AddReader before it starts reading and RemoveReader
+ * once it is done, and the SDK is not read while no reader is registered. Beats detected in the meantime are lost and
+ * counted as a gap.
+ */
+class heartbeat_stream : public realtime_source {
+ public:
+  // About an hour of beats at 70 BPM.
+  static constexpr std::size_t kDefaultCapacity = 4096;
+  // Long enough to span several poll intervals, short enough to keep each poll cheap.
+  static constexpr float kDefaultPollPeriodSec = 5.0f;
+  // Beats starting this close to an appended beat are the same beat. Well under the shortest beat at 220 BPM.
+  static constexpr double kSameBeatToleranceSec = 0.1;
+
+  /**
+   * Creates the stream.
+   * @param capacity The number of most recent beats kept for readers.
+   * @param poll_period_sec The period passed to GetRealtimeHeartbeats on each poll.
+   */
+  explicit heartbeat_stream(std::size_t capacity = kDefaultCapacity, float poll_period_sec = kDefaultPollPeriodSec);
+
+  void Poll(double timestamp_sec) override;
+  bool IsActive() const override { return readers_.load(std::memory_order_relaxed) != 0; }
+
+  /**
+   * Registers a reader, making the stream active. Safe to call from any thread.
+   */
+  void AddReader() const { readers_.fetch_add(1, std::memory_order_relaxed); }
+
+  /**
+   * Removes a reader registered with AddReader; the stream goes inactive with the last one. Safe to call from any
+   * thread.
+   */
+  void RemoveReader() const { readers_.fetch_sub(1, std::memory_order_relaxed); }
+
+  /**
+   * Appends the beats of `beats` (ordered by start location) that start after the last appended beat, beyond
+   * kSameBeatToleranceSec. A window that ends before the last appended beat is taken as a new measurement, and all of
+   * its beats are appended. A window that starts after the end of the last appended beat counts as a gap.
+   * @note Producer side: must only be called from one thread at a time, normally through Poll.
+   * @return The number of beats appended.
+   */
+  std::size_t Append(span<const heartbeat> beats);
+
+  /**
+   * Copies the beats detected after `cursor` into `out`, oldest first, and advances `cursor` past them. If beats after
+   * `cursor` were already evicted from the history, reading resumes at the oldest beat still kept.
+   * @return The number of beats copied, at most `out.size()`.
+   */
+  std::size_t Read(heartbeat_cursor& cursor, span<heartbeat> out) const;
+
+  /**
+   * Gets the cursor just past the newest beat; a reader holding it is up to date.
+   */
+  heartbeat_cursor GetEnd() const;
+
+  /**
+   * Gets the number of times beats were missed because the polls were further apart than the poll period.
+   */
+  std::uint64_t GetGapCount() const { return gaps_.load(std::memory_order_relaxed); }
+
+ private:
+  float poll_period_sec_;
+
+  mutable std::mutex mutex_;
+  cursor_ring<heartbeat> beats_;
+  double last_start_sec_{0.0};
+  double last_end_sec_{0.0};
+  std::atomic<std::uint64_t> gaps_{0};
+  mutable std::atomic<std::size_t> readers_{0};
+};
+
+}  // namespace shen
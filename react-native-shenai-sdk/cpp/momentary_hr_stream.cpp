@@ -0,0 +1,52 @@
+#include "momentary_hr_stream.h"
+
+#include <array>
+#include <cmath>
+
+namespace shen {
+
+std::optional<momentary_hr_value> GetMomentaryHeartRate(const heartbeat& beat) {
+  if (!(beat.duration_ms > 0.0) || !std::isfinite(beat.duration_ms)) {
+    return std::nullopt;
+  }
+  return momentary_hr_value{beat.end_location_sec, static_cast<int>(std::lround(60000.0 / beat.duration_ms))};
+}
+
+momentary_hr_stream::momentary_hr_stream(const heartbeat_stream& stream, std::size_t capacity)
+    : stream_(stream), values_(capacity) {
+  stream_.AddReader();
+}
+
+momentary_hr_stream::~momentary_hr_stream() { stream_.RemoveReader(); }
+
+void momentary_hr_stream::Poll(double /*timestamp_sec*/) {
+  constexpr std::size_t kBatchSize = 64;
+  std::array<heartbeat, kBatchSize> batch;
+  std::size_t count;
+  while ((count = stream_.Read(cursor_, batch)) != 0) {
+    Append(span<const heartbeat>(batch.data(), count));
+  }
+}
+
+std::size_t momentary_hr_stream::Append(span<const heartbeat> beats) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const std::uint64_t begin = values_.GetEnd();
+  for (const heartbeat& beat : beats) {
+    if (const auto value = GetMomentaryHeartRate(beat)) {
+      values_.Push(*value);
+    }
+  }
+  return static_cast<std::size_t>(values_.GetEnd() - begin);
+}
+
+std::size_t momentary_hr_stream::Read(momentary_hr_cursor& cursor, span<momentary_hr_value> out) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return values_.Read(cursor, out);
+}
+
+momentary_hr_cursor momentary_hr_stream::GetEnd() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return values_.GetEnd();
+}
+
+}  // namespace shen
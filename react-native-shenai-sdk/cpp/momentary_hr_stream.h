@@ -0,0 +1,78 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "cursor_ring.h"
+#include "heartbeat_stream.h"
+#include "realtime_poller.h"
+#include "span.h"
+
+namespace shen {
+
+/**
+ * Position of a reader in a momentary_hr_stream: the sequence number of the next value to read. Start from 0.
+ */
+using momentary_hr_cursor = std::uint64_t;
+
+/**
+ * Gets the momentary heart rate of a single beat, timestamped at its end.
+ * @return The heart rate, or std::nullopt if the beat has no positive, finite duration.
+ */
+std::optional<momentary_hr_value> GetMomentaryHeartRate(const heartbeat& beat);
+
+/**
+ * Beat-by-beat heart rate series, as a fixed-capacity history read incrementally.
+ * Registered with a realtime_poller after the heartbeat_stream it reads from, it follows that stream with its own
+ * cursor and appends one momentary_hr_value per new beat. Readers keep a momentary_hr_cursor and copy only the values
+ * added after it into a buffer of their own, so memory stays constant however long the session runs and each read
+ * costs only the new values. It is a reader of the heartbeat stream for its whole lifetime.
+ */
+class momentary_hr_stream : public realtime_source {
+ public:
+  // About an hour of beats at 70 BPM.
+  static constexpr std::size_t kDefaultCapacity = 4096;
+
+  /**
+   * Creates the stream.
+   * @param stream The stream whose beats feed the series; must outlive this object.
+   * @param capacity The number of most recent values kept for readers.
+   */
+  explicit momentary_hr_stream(const heartbeat_stream& stream, std::size_t capacity = kDefaultCapacity);
+  ~momentary_hr_stream() override;
+
+  void Poll(double timestamp_sec) override;
+
+  /**
+   * Appends the momentary heart rate of each of `beats`, skipping beats GetMomentaryHeartRate has no value for.
+   * Polling calls this with the new beats of the stream.
+   * @note Producer side: must only be called from one thread at a time.
+   * @return The number of values appended.
+   */
+  std::size_t Append(span<const heartbeat> beats);
+
+  /**
+   * Copies the values added after `cursor` into `out`, oldest first, and advances `cursor` past them. If values after
+   * `cursor` were already evicted from the history, reading resumes at the oldest value still kept.
+   * @return The number of values copied, at most `out.size()`.
+   */
+  std::size_t Read(momentary_hr_cursor& cursor, span<momentary_hr_value> out) const;
+
+  /**
+   * Gets the cursor just past the newest value; a reader holding it is up to date.
+   */
+  momentary_hr_cursor GetEnd() const;
+
+ private:
+  const heartbeat_stream& stream_;
+  heartbeat_cursor cursor_{0};
+
+  mutable std::mutex mutex_;
+  cursor_ring<momentary_hr_value> values_;
+};
+
+}  // namespace shen
@@ -0,0 +1,246 @@
+#include "packed_risks.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+namespace shen {
+
+namespace {
+
+// Bit of packed_health_risks::presence for each result, in the declaration order of HealthRisks.
+enum HealthRisksBit : unsigned {
+  kWellnessScore,
+  kCoronaryDeathEventRisk,
+  kFatalStrokeEventRisk,
+  kTotalCvMortalityRisk,
+  kHardCvEventRisk,
+  kOverallRisk,
+  kCoronaryHeartDiseaseRisk,
+  kStrokeRisk,
+  kHeartFailureRisk,
+  kPeripheralVascularDiseaseRisk,
+  kVascularAge,
+  kAgeScore,
+  kSbpScore,
+  kSmokingScore,
+  kDiabetesScore,
+  kBmiScore,
+  kCholesterolScore,
+  kCholesterolHdlScore,
+  kTotalScore,
+  kWaistToHeightRatio,
+  kBodyFatPercentage,
+  kBasalMetabolicRate,
+  kBodyRoundnessIndex,
+  kConicityIndex,
+  kABodyShapeIndex,
+  kTotalDailyEnergyExpenditure,
+  kHypertensionRisk,
+  kDiabetesRisk,
+  kNonAlcoholicFattyLiverDiseaseRisk,
+};
+
+template <typename Packed, typename T, typename Mask>
+void Put(const std::optional<T>& value, Packed& out, Mask& presence, Mask bit) {
+  if (value) {
+    out = static_cast<Packed>(*value);
+    presence |= bit;
+  }
+}
+
+template <typename T, typename Packed, typename Mask>
+void Get(Packed value, Mask presence, Mask bit, std::optional<T>& out) {
+  if (presence & bit) {
+    out = static_cast<T>(value);
+  } else {
+    out.reset();
+  }
+}
+
+void PutFlag(const std::optional<bool>& value, packed_risks_factors& p, RiskFactor factor) {
+  if (value) {
+    p.presence |= RiskFactorBit(factor);
+    if (*value) {
+      p.yes |= RiskFactorBit(factor);
+    }
+  }
+}
+
+void GetFlag(const packed_risks_factors& p, RiskFactor factor, std::optional<bool>& out) {
+  if (p.Has(factor)) {
+    out = (p.yes & RiskFactorBit(factor)) != 0;
+  } else {
+    out.reset();
+  }
+}
+
+constexpr std::uint32_t Bit(HealthRisksBit bit) { return std::uint32_t{1} << bit; }
+
+}  // namespace
+
+std::optional<packed_risks_factors> Pack(const mx::health_risks::RisksFactors& f) {
+  const std::optional<country_code> country = country_code::FromString(f.country);
+  if (!country) {
+    return std::nullopt;
+  }
+  packed_risks_factors p;
+  auto put = [&p](const auto& value, auto& out, RiskFactor factor) {
+    Put(value, out, p.presence, RiskFactorBit(factor));
+  };
+
+  if (f.age) {
+    p.age = static_cast<std::int16_t>(std::clamp<int>(*f.age, std::numeric_limits<std::int16_t>::min(),
+                                                      std::numeric_limits<std::int16_t>::max()));
+    p.presence |= RiskFactorBit(RiskFactor::Age);
+  }
+  put(f.cholesterol, p.cholesterol, RiskFactor::Cholesterol);
+  put(f.cholesterol_hdl, p.cholesterol_hdl, RiskFactor::CholesterolHdl);
+  put(f.sbp, p.sbp, RiskFactor::Sbp);
+  put(f.dbp, p.dbp, RiskFactor::Dbp);
+  PutFlag(f.is_smoker, p, RiskFactor::IsSmoker);
+  put(f.hypertension_treatment, p.hypertension_treatment, RiskFactor::HypertensionTreatment);
+  PutFlag(f.has_diabetes, p, RiskFactor::HasDiabetes);
+  put(f.body_height, p.body_height, RiskFactor::BodyHeight);
+  put(f.body_weight, p.body_weight, RiskFactor::BodyWeight);
+  put(f.waist_circumference, p.waist_circumference, RiskFactor::WaistCircumference);
+  put(f.physical_activity, p.physical_activity, RiskFactor::PhysicalActivity);
+  put(f.gender, p.gender, RiskFactor::Gender);
+  p.country = *country;
+  if (!p.country.IsEmpty()) {
+    p.presence |= RiskFactorBit(RiskFactor::Country);
+  }
+  put(f.race, p.race, RiskFactor::Race);
+  put(f.parental_hypertension, p.parental_hypertension, RiskFactor::ParentalHypertension);
+  put(f.family_diabetes, p.family_diabetes, RiskFactor::FamilyDiabetes);
+  put(f.triglyceride, p.triglyceride, RiskFactor::Triglyceride);
+  put(f.fasting_glucose, p.fasting_glucose, RiskFactor::FastingGlucose);
+  PutFlag(f.vegetable_fruit_diet, p, RiskFactor::VegetableFruitDiet);
+  PutFlag(f.history_of_high_glucose, p, RiskFactor::HistoryOfHighGlucose);
+  PutFlag(f.history_of_hypertension, p, RiskFactor::HistoryOfHypertension);
+  return p;
+}
+
+void Unpack(const packed_risks_factors& p, mx::health_risks::RisksFactors& f) {
+  auto get = [&p](auto value, RiskFactor factor, auto& out) { Get(value, p.presence, RiskFactorBit(factor), out); };
+
+  get(p.age, RiskFactor::Age, f.age);
+  get(p.cholesterol, RiskFactor::Cholesterol, f.cholesterol);
+  get(p.cholesterol_hdl, RiskFactor::CholesterolHdl, f.cholesterol_hdl);
+  get(p.sbp, RiskFactor::Sbp, f.sbp);
+  get(p.dbp, RiskFactor::Dbp, f.dbp);
+  GetFlag(p, RiskFactor::IsSmoker, f.is_smoker);
+  get(p.hypertension_treatment, RiskFactor::HypertensionTreatment, f.hypertension_treatment);
+  GetFlag(p, RiskFactor::HasDiabetes, f.has_diabetes);
+  get(p.body_height, RiskFactor::BodyHeight, f.body_height);
+  get(p.body_weight, RiskFactor::BodyWeight, f.body_weight);
+  get(p.waist_circumference, RiskFactor::WaistCircumference, f.waist_circumference);
+  get(p.physical_activity, RiskFactor::PhysicalActivity, f.physical_activity);
+  get(p.gender, RiskFactor::Gender, f.gender);
+  p.country.AssignTo(f.country);
+  get(p.race, RiskFactor::Race, f.race);
+  get(p.parental_hypertension, RiskFactor::ParentalHypertension, f.parental_hypertension);
+  get(p.family_diabetes, RiskFactor::FamilyDiabetes, f.family_diabetes);
+  get(p.triglyceride, RiskFactor::Triglyceride, f.triglyceride);
+  get(p.fasting_glucose, RiskFactor::FastingGlucose, f.fasting_glucose);
+  GetFlag(p, RiskFactor::VegetableFruitDiet, f.vegetable_fruit_diet);
+  GetFlag(p, RiskFactor::HistoryOfHighGlucose, f.history_of_high_glucose);
+  GetFlag(p, RiskFactor::HistoryOfHypertension, f.history_of_hypertension);
+}
+
+packed_health_risks Pack(const mx::health_risks::HealthRisks& r) {
+  packed_health_risks p;
+  auto put = [&p](const auto& value, auto& out, HealthRisksBit bit) { Put(value, out, p.presence, Bit(bit)); };
+
+  put(r.wellness_score, p.wellness_score, kWellnessScore);
+  put(r.hard_and_fatal_events.coronary_death_event_risk, p.coronary_death_event_risk, kCoronaryDeathEventRisk);
+  put(r.hard_and_fatal_events.fatal_stroke_event_risk, p.fatal_stroke_event_risk, kFatalStrokeEventRisk);
+  put(r.hard_and_fatal_events.total_cv_mortality_risk, p.total_cv_mortality_risk, kTotalCvMortalityRisk);
+  put(r.hard_and_fatal_events.hard_cv_event_risk, p.hard_cv_event_risk, kHardCvEventRisk);
+  put(r.cv_diseases.overall_risk, p.overall_risk, kOverallRisk);
+  put(r.cv_diseases.coronary_heart_disease_risk, p.coronary_heart_disease_risk, kCoronaryHeartDiseaseRisk);
+  put(r.cv_diseases.stroke_risk, p.stroke_risk, kStrokeRisk);
+  put(r.cv_diseases.heart_failure_risk, p.heart_failure_risk, kHeartFailureRisk);
+  put(r.cv_diseases.peripheral_vascular_disease_risk, p.peripheral_vascular_disease_risk,
+      kPeripheralVascularDiseaseRisk);
+  put(r.vascular_age, p.vascular_age, kVascularAge);
+  put(r.scores.age_score, p.age_score, kAgeScore);
+  put(r.scores.sbp_score, p.sbp_score, kSbpScore);
+  put(r.scores.smoking_score, p.smoking_score, kSmokingScore);
+  put(r.scores.diabetes_score, p.diabetes_score, kDiabetesScore);
+  put(r.scores.bmi_score, p.bmi_score, kBmiScore);
+  put(r.scores.cholesterol_score, p.cholesterol_score, kCholesterolScore);
+  put(r.scores.cholesterol_hdl_score, p.cholesterol_hdl_score, kCholesterolHdlScore);
+  put(r.scores.total_score, p.total_score, kTotalScore);
+  put(r.waist_to_height_ratio, p.waist_to_height_ratio, kWaistToHeightRatio);
+  put(r.body_fat_percentage, p.body_fat_percentage, kBodyFatPercentage);
+  put(r.basal_metabolic_rate, p.basal_metabolic_rate, kBasalMetabolicRate);
+  put(r.body_roundness_index, p.body_roundness_index, kBodyRoundnessIndex);
+  put(r.conicity_index, p.conicity_index, kConicityIndex);
+  put(r.a_body_shape_index, p.a_body_shape_index, kABodyShapeIndex);
+  put(r.total_daily_energy_expenditure, p.total_daily_energy_expenditure, kTotalDailyEnergyExpenditure);
+  put(r.hypertension_risk, p.hypertension_risk, kHypertensionRisk);
+  put(r.diabetes_risk, p.diabetes_risk, kDiabetesRisk);
+  put(r.non_alcoholic_fatty_liver_disease_risk, p.non_alcoholic_fatty_liver_disease_risk,
+      kNonAlcoholicFattyLiverDiseaseRisk);
+  return p;
+}
+
+mx::health_risks::HealthRisks Unpack(const packed_health_risks& p) {
+  mx::health_risks::HealthRisks r;
+  auto get = [&p](auto value, HealthRisksBit bit, auto& out) { Get(value, p.presence, Bit(bit), out); };
+
+  get(p.wellness_score, kWellnessScore, r.wellness_score);
+  get(p.coronary_death_event_risk, kCoronaryDeathEventRisk, r.hard_and_fatal_events.coronary_death_event_risk);
+  get(p.fatal_stroke_event_risk, kFatalStrokeEventRisk, r.hard_and_fatal_events.fatal_stroke_event_risk);
+  get(p.total_cv_mortality_risk, kTotalCvMortalityRisk, r.hard_and_fatal_events.total_cv_mortality_risk);
+  get(p.hard_cv_event_risk, kHardCvEventRisk, r.hard_and_fatal_events.hard_cv_event_risk);
+  get(p.overall_risk, kOverallRisk, r.cv_diseases.overall_risk);
+  get(p.coronary_heart_disease_risk, kCoronaryHeartDiseaseRisk, r.cv_diseases.coronary_heart_disease_risk);
+  get(p.stroke_risk, kStrokeRisk, r.cv_diseases.stroke_risk);
+  get(p.heart_failure_risk, kHeartFailureRisk, r.cv_diseases.heart_failure_risk);
+  get(p.peripheral_vascular_disease_risk, kPeripheralVascularDiseaseRisk,
+      r.cv_diseases.peripheral_vascular_disease_risk);
+  get(p.vascular_age, kVascularAge, r.vascular_age);
+  get(p.age_score, kAgeScore, r.scores.age_score);
+  get(p.sbp_score, kSbpScore, r.scores.sbp_score);
+  get(p.smoking_score, kSmokingScore, r.scores.smoking_score);
+  get(p.diabetes_score, kDiabetesScore, r.scores.diabetes_score);
+  get(p.bmi_score, kBmiScore, r.scores.bmi_score);
+  get(p.cholesterol_score, kCholesterolScore, r.scores.cholesterol_score);
+  get(p.cholesterol_hdl_score, kCholesterolHdlScore, r.scores.cholesterol_hdl_score);
+  get(p.total_score, kTotalScore, r.scores.total_score);
+  get(p.waist_to_height_ratio, kWaistToHeightRatio, r.waist_to_height_ratio);
+  get(p.body_fat_percentage, kBodyFatPercentage, r.body_fat_percentage);
+  get(p.basal_metabolic_rate, kBasalMetabolicRate, r.basal_metabolic_rate);
+  get(p.body_roundness_index, kBodyRoundnessIndex, r.body_roundness_index);
+  get(p.conicity_index, kConicityIndex, r.conicity_index);
+  get(p.a_body_shape_index, kABodyShapeIndex, r.a_body_shape_index);
+  get(p.total_daily_energy_expenditure, kTotalDailyEnergyExpenditure, r.total_daily_energy_expenditure);
+  get(p.hypertension_risk, kHypertensionRisk, r.hypertension_risk);
+  get(p.diabetes_risk, kDiabetesRisk, r.diabetes_risk);
+  get(p.non_alcoholic_fatty_liver_disease_risk, kNonAlcoholicFattyLiverDiseaseRisk,
+      r.non_alcoholic_fatty_liver_disease_risk);
+  return r;
+}
+
+mx::health_risks::HealthRisks ComputeHealthRisks(const packed_risks_factors& risk_factors) {
+  thread_local mx::health_risks::RisksFactors scratch;
+  Unpack(risk_factors, scratch);
+  return ComputeHealthRisks(scratch);
+}
+
+std::size_t ComputeHealthRisks(span<const packed_risks_factors> risk_factors, span<packed_health_risks> health_risks,
+                               thread_pool& pool, std::size_t grain_size) {
+  const std::size_t count = std::min(risk_factors.size(), health_risks.size());
+  pool.ParallelFor(count, grain_size, [&](std::size_t begin, std::size_t end) {
+    mx::health_risks::RisksFactors row;
+    for (std::size_t i = begin; i < end; ++i) {
+      Unpack(risk_factors[i], row);
+      health_risks[i] = Pack(ComputeHealthRisks(row));
+    }
+  });
+  return count;
+}
+
+}  // namespace shen
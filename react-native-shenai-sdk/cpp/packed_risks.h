@@ -0,0 +1,117 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "country_code.h"
+#include "health_risks_batch.h"
+#include "risk_factor.h"
+
+namespace shen {
+
+/**
+ * Compact counterpart of mx::health_risks::RisksFactors for keeping large cohorts in memory.
+ * Presence of every factor is kept in a single bitmask instead of per-field optional flags, yes/no factors are bits
+ * of a second mask, enums are stored in one byte and the country as a country_code. The value stored for a missing
+ * factor is zero and must be ignored.
+ */
+struct packed_risks_factors {
+  risk_factor_mask presence{0};  // RiskFactorBit(f) is set when factor f is provided
+  risk_factor_mask yes{0};       // RiskFactorBit(f) is set when the yes/no factor f is true
+
+  float cholesterol{0};
+  float cholesterol_hdl{0};
+  float sbp{0};
+  float dbp{0};
+  float body_height{0};          // centimeters
+  float body_weight{0};          // kilograms
+  float waist_circumference{0};  // centimeters
+  float triglyceride{0};
+  float fasting_glucose{0};
+
+  std::int16_t age{0};
+  country_code country;
+
+  std::int8_t hypertension_treatment{0};
+  std::int8_t physical_activity{0};
+  std::int8_t gender{0};
+  std::int8_t race{0};
+  std::int8_t parental_hypertension{0};
+  std::int8_t family_diabetes{0};
+
+  bool Has(RiskFactor factor) const { return (presence & RiskFactorBit(factor)) != 0; }
+};
+
+/**
+ * Compact counterpart of mx::health_risks::HealthRisks. Presence of every result is kept in a single bitmask,
+ * results computed in double precision are rounded to float, scores and the vascular age are stored in 16 bits.
+ */
+struct packed_health_risks {
+  std::uint32_t presence{0};
+
+  float wellness_score{0};
+  float coronary_death_event_risk{0};
+  float fatal_stroke_event_risk{0};
+  float total_cv_mortality_risk{0};
+  float hard_cv_event_risk{0};
+  float overall_risk{0};
+  float coronary_heart_disease_risk{0};
+  float stroke_risk{0};
+  float heart_failure_risk{0};
+  float peripheral_vascular_disease_risk{0};
+  float waist_to_height_ratio{0};
+  float body_fat_percentage{0};
+  float basal_metabolic_rate{0};
+  float body_roundness_index{0};
+  float conicity_index{0};
+  float a_body_shape_index{0};
+  float total_daily_energy_expenditure{0};
+  float hypertension_risk{0};
+  float diabetes_risk{0};
+
+  std::int16_t vascular_age{0};
+  std::int16_t age_score{0};
+  std::int16_t sbp_score{0};
+  std::int16_t smoking_score{0};
+  std::int16_t diabetes_score{0};
+  std::int16_t bmi_score{0};
+  std::int16_t cholesterol_score{0};
+  std::int16_t cholesterol_hdl_score{0};
+  std::int16_t total_score{0};
+
+  std::int8_t non_alcoholic_fatty_liver_disease_risk{0};
+};
+
+/**
+ * Packs risk factors. Ages are stored in 16 bits.
+ * @return The packed factors, or std::nullopt if the country is neither empty nor two ASCII letters and therefore has
+ * no country_code representation.
+ */
+std::optional<packed_risks_factors> Pack(const mx::health_risks::RisksFactors& risk_factors);
+
+/**
+ * Unpacks risk factors into `risk_factors`, reusing its country string buffer, so this never allocates.
+ */
+void Unpack(const packed_risks_factors& packed, mx::health_risks::RisksFactors& risk_factors);
+
+packed_health_risks Pack(const mx::health_risks::HealthRisks& health_risks);
+mx::health_risks::HealthRisks Unpack(const packed_health_risks& packed);
+
+/**
+ * Computes the health risks of packed risk factors.
+ * The factors are unpacked into a thread-local scratch object, so the conversion does not allocate.
+ */
+mx::health_risks::HealthRisks ComputeHealthRisks(const packed_risks_factors& risk_factors);
+
+/**
+ * Computes the packed health risks of a packed cohort; see the span overload of ComputeHealthRisks.
+ * @return The number of records computed: the smaller of the two span sizes.
+ */
+std::size_t ComputeHealthRisks(span<const packed_risks_factors> risk_factors, span<packed_health_risks> health_risks,
+                               thread_pool& pool = DefaultThreadPool(),
+                               std::size_t grain_size = kDefaultRiskBatchGrainSize);
+
+}  // namespace shen
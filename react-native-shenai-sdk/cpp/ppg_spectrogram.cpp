@@ -0,0 +1,70 @@
+#include "ppg_spectrogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace shen {
+
+ppg_spectrogram::ppg_spectrogram(callback on_spectrum, std::size_t window_size, std::size_t hop_size,
+                                 float sample_rate_hz)
+    : on_spectrum_(std::move(on_spectrum)),
+      hop_size_(std::max<std::size_t>(hop_size, 1)),
+      sample_rate_hz_(sample_rate_hz),
+      fft_(window_size),
+      window_(fft_.GetSize()),
+      history_(fft_.GetSize()),
+      frame_(fft_.GetSize()),
+      power_(fft_.GetBinCount()) {
+  // Periodic Hann window, which keeps its overlap-add constant for hops that divide the window size by 2 or more.
+  const double pi = std::acos(-1.0);
+  const auto size = static_cast<double>(window_.size());
+  for (std::size_t i = 0; i < window_.size(); ++i) {
+    window_[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * pi * static_cast<double>(i) / size));
+  }
+  Reset();
+}
+
+double ppg_spectrogram::GetBinFrequencyHz(std::size_t bin) const {
+  return static_cast<double>(bin) * static_cast<double>(sample_rate_hz_) / static_cast<double>(fft_.GetSize());
+}
+
+void ppg_spectrogram::Reset() {
+  pushed_ = 0;
+  next_frame_ = history_.size();
+  frames_ = 0;
+}
+
+std::size_t ppg_spectrogram::Push(span<const float> samples) {
+  const std::size_t mask = history_.size() - 1;
+  std::size_t produced = 0;
+  for (const float sample : samples) {
+    history_[pushed_ & mask] = sample;
+    if (++pushed_ == next_frame_) {
+      Emit(static_cast<double>(pushed_ - 1) / static_cast<double>(sample_rate_hz_));
+      next_frame_ += hop_size_;
+      ++produced;
+    }
+  }
+  return produced;
+}
+
+void ppg_spectrogram::Emit(double nominal_time_sec) {
+  // The oldest sample of the window sits right after the newest one in the ring; unroll it in two straight runs.
+  const std::size_t size = history_.size();
+  const std::size_t oldest = static_cast<std::size_t>(pushed_ & (size - 1));
+  const std::size_t tail = size - oldest;
+  for (std::size_t i = 0; i < tail; ++i) {
+    frame_[i] = history_[oldest + i] * window_[i];
+  }
+  for (std::size_t i = tail; i < size; ++i) {
+    frame_[i] = history_[i - tail] * window_[i];
+  }
+  fft_.Power(frame_, power_);
+  if (on_spectrum_) {
+    on_spectrum_({nominal_time_sec, frames_, power_});
+  }
+  ++frames_;
+}
+
+}  // namespace shen
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "real_fft.h"
+#include "span.h"
+
+namespace shen {
+
+/**
+ * One column of a PPG spectrogram.
+ */
+struct ppg_spectrum {
+  double nominal_time_sec;  // position of the newest sample in the window divided by the sample rate
+  std::uint64_t index;      // number of the frame since the last reset
+  span<const float> power;  // |X_k|^2 of the Hann-windowed samples, bin k at k * sample rate / window size
+};
+
+/**
+ * Short-time Fourier transform of a PPG signal, computed incrementally as samples are pushed.
+ *
+ * This is an offline analysis, not a live view: the SDK only provides the PPG signal through GetFullPPGSignal once a
+ * measurement has finished, so a measurement's spectrogram is computed afterwards from that signal. The SDK does not
+ * report when samples were taken, so frame times and bin frequencies follow from the sample position and an assumed
+ * sample rate, by default one sample per camera frame at 30 Hz.
+ *
+ * Samples go into a ring holding the last window; once the window is full, every `hop_size` new samples produce a
+ * spectrum of the newest window, weighted by a precomputed Hann window, through a real_fft. Each hop therefore costs
+ * one transform of the window whatever the length of the signal so far, and the power spectrum is written into a
+ * buffer reused for every frame.
+ */
+class ppg_spectrogram {
+ public:
+  /**
+   * Called for each new spectrum; `spectrum.power` is only valid during the call.
+   */
+  using callback = std::function<void(const ppg_spectrum&)>;
+
+  // About 8.5 seconds at 30 Hz, for a resolution of about 0.23 Hz (14 BPM).
+  static constexpr std::size_t kDefaultWindowSize = 256;
+  // About one spectrum per second at 30 Hz.
+  static constexpr std::size_t kDefaultHopSize = 32;
+  // Assumed: one sample per camera frame at the nominal camera frame rate.
+  static constexpr float kDefaultSampleRateHz = 30.0f;
+
+  /**
+   * Creates the spectrogram.
+   * @param on_spectrum Receives each new spectrum.
+   * @param window_size The number of samples per window, rounded up to a power of two of at least 4.
+   * @param hop_size The number of new samples between spectra, at least 1.
+   * @param sample_rate_hz The (assumed) sample rate of the signal, used for frame times and GetBinFrequencyHz.
+   */
+  explicit ppg_spectrogram(callback on_spectrum, std::size_t window_size = kDefaultWindowSize,
+                           std::size_t hop_size = kDefaultHopSize, float sample_rate_hz = kDefaultSampleRateHz);
+
+  std::size_t GetWindowSize() const { return fft_.GetSize(); }
+  std::size_t GetHopSize() const { return hop_size_; }
+  std::size_t GetBinCount() const { return fft_.GetBinCount(); }
+  double GetBinFrequencyHz(std::size_t bin) const;
+
+  /**
+   * Appends samples of the signal, calling back with a spectrum for every hop completed. Call Reset before the samples
+   * of another signal, e.g. the next measurement's.
+   * @return The number of spectra produced.
+   */
+  std::size_t Push(span<const float> samples);
+
+  /**
+   * Discards the samples of the current window and restarts frame numbering.
+   */
+  void Reset();
+
+ private:
+  void Emit(double nominal_time_sec);
+
+  callback on_spectrum_;
+  std::size_t hop_size_;
+  float sample_rate_hz_;
+  real_fft fft_;
+
+  std::vector<float> window_;   // Hann weights
+  std::vector<float> history_;  // ring of the last window of samples, indexed by sample number % window size
+  std::vector<float> frame_;    // the windowed samples of the current frame
+  std::vector<float> power_;
+
+  std::uint64_t pushed_{0};      // samples since the last reset
+  std::uint64_t next_frame_{0};  // value of pushed_ at which the next spectrum is due
+  std::uint64_t frames_{0};
+};
+
+}  // namespace shen
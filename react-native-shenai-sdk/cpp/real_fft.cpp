@@ -0,0 +1,120 @@
+#include "real_fft.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace shen {
+
+namespace {
+
+std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+  std::size_t result = 4;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+/**
+ * Splits the transform Z of the packed signal into bins 0..N/2 of the real transform, calling `store(k, re, im)` for
+ * each: X_k = (Z_k + conj Z_{M-k}) / 2 + exp(-2 pi i k / N) (Z_k - conj Z_{M-k}) / 2i, with M = N / 2 and Z_M = Z_0.
+ */
+template <typename Store>
+void Split(const float* real, const float* imag, const float* split_real, const float* split_imag, std::size_t half,
+           Store store) {
+  for (std::size_t k = 0; k <= half; ++k) {
+    const std::size_t a = k == half ? 0 : k;
+    const std::size_t b = k == 0 ? 0 : half - k;
+    const float even_real = 0.5f * (real[a] + real[b]);
+    const float even_imag = 0.5f * (imag[a] - imag[b]);
+    const float odd_real = 0.5f * (imag[a] + imag[b]);
+    const float odd_imag = -0.5f * (real[a] - real[b]);
+    store(k, even_real + split_real[k] * odd_real - split_imag[k] * odd_imag,
+          even_imag + split_real[k] * odd_imag + split_imag[k] * odd_real);
+  }
+}
+
+}  // namespace
+
+real_fft::real_fft(std::size_t size)
+    : size_(RoundUpToPowerOfTwo(size)),
+      half_(size_ / 2),
+      bit_reversed_(half_),
+      twiddle_real_(half_ - 1),
+      twiddle_imag_(half_ - 1),
+      split_real_(half_ + 1),
+      split_imag_(half_ + 1),
+      real_(half_),
+      imag_(half_) {
+  std::size_t bits = 0;
+  while ((std::size_t{1} << bits) < half_) {
+    ++bits;
+  }
+  for (std::size_t i = 0; i < half_; ++i) {
+    std::uint32_t reversed = 0;
+    for (std::size_t bit = 0; bit < bits; ++bit) {
+      reversed |= static_cast<std::uint32_t>((i >> bit) & 1) << (bits - 1 - bit);
+    }
+    bit_reversed_[i] = reversed;
+  }
+
+  // Twiddles are computed in double and rounded once.
+  const double pi = std::acos(-1.0);
+  for (std::size_t stage_half = 1; stage_half < half_; stage_half <<= 1) {
+    for (std::size_t j = 0; j < stage_half; ++j) {
+      const double angle = -pi * static_cast<double>(j) / static_cast<double>(stage_half);
+      twiddle_real_[stage_half - 1 + j] = static_cast<float>(std::cos(angle));
+      twiddle_imag_[stage_half - 1 + j] = static_cast<float>(std::sin(angle));
+    }
+  }
+  for (std::size_t k = 0; k <= half_; ++k) {
+    const double angle = -2.0 * pi * static_cast<double>(k) / static_cast<double>(size_);
+    split_real_[k] = static_cast<float>(std::cos(angle));
+    split_imag_[k] = static_cast<float>(std::sin(angle));
+  }
+}
+
+void real_fft::Forward(span<const float> input) {
+  // Even samples become the real parts and odd samples the imaginary parts, in bit-reversed order.
+  for (std::size_t i = 0; i < half_; ++i) {
+    real_[bit_reversed_[i]] = input[2 * i];
+    imag_[bit_reversed_[i]] = input[2 * i + 1];
+  }
+  float* const real = real_.data();
+  float* const imag = imag_.data();
+  for (std::size_t stage_half = 1; stage_half < half_; stage_half <<= 1) {
+    const float* const twiddle_real = twiddle_real_.data() + stage_half - 1;
+    const float* const twiddle_imag = twiddle_imag_.data() + stage_half - 1;
+    for (std::size_t start = 0; start < half_; start += 2 * stage_half) {
+      float* const top_real = real + start;
+      float* const top_imag = imag + start;
+      float* const bottom_real = top_real + stage_half;
+      float* const bottom_imag = top_imag + stage_half;
+      for (std::size_t j = 0; j < stage_half; ++j) {
+        const float t_real = twiddle_real[j] * bottom_real[j] - twiddle_imag[j] * bottom_imag[j];
+        const float t_imag = twiddle_real[j] * bottom_imag[j] + twiddle_imag[j] * bottom_real[j];
+        bottom_real[j] = top_real[j] - t_real;
+        bottom_imag[j] = top_imag[j] - t_imag;
+        top_real[j] += t_real;
+        top_imag[j] += t_imag;
+      }
+    }
+  }
+}
+
+void real_fft::Transform(span<const float> input, span<float> real, span<float> imag) {
+  Forward(input);
+  Split(real_.data(), imag_.data(), split_real_.data(), split_imag_.data(), half_,
+        [&](std::size_t k, float re, float im) {
+          real[k] = re;
+          imag[k] = im;
+        });
+}
+
+void real_fft::Power(span<const float> input, span<float> power) {
+  Forward(input);
+  Split(real_.data(), imag_.data(), split_real_.data(), split_imag_.data(), half_,
+        [&](std::size_t k, float re, float im) { power[k] = re * re + im * im; });
+}
+
+}  // namespace shen
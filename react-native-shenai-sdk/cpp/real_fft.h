@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "span.h"
+
+namespace shen {
+
+/**
+ * Fast Fourier transform of real signals of a fixed power-of-two size, with all tables and buffers allocated up front.
+ *
+ * The N real samples are packed into N/2 complex values and transformed with an iterative radix-2 FFT, then split into
+ * the N/2 + 1 non-negative frequency bins. Real and imaginary parts are kept in separate arrays and the twiddle factors
+ * of each stage are stored contiguously, so the butterfly loops are straight loops the compiler vectorizes.
+ */
+class real_fft {
+ public:
+  /**
+   * Prepares the transform.
+   * @param size The number of samples, rounded up to a power of two of at least 4.
+   */
+  explicit real_fft(std::size_t size);
+
+  std::size_t GetSize() const { return size_; }
+  std::size_t GetBinCount() const { return size_ / 2 + 1; }
+
+  /**
+   * Transforms `input` (GetSize() samples) into GetBinCount() bins, unnormalized: bin k is the sum over n of
+   * input[n] * exp(-2 pi i k n / N).
+   * @note Not thread-safe: the transform works in buffers owned by this object.
+   */
+  void Transform(span<const float> input, span<float> real, span<float> imag);
+
+  /**
+   * Transforms `input` like Transform and writes the power |X_k|^2 of each bin into `power`.
+   */
+  void Power(span<const float> input, span<float> power);
+
+ private:
+  void Forward(span<const float> input);
+
+  std::size_t size_;
+  std::size_t half_;  // size of the complex transform
+
+  std::vector<std::uint32_t> bit_reversed_;
+  std::vector<float> twiddle_real_;  // per stage of length L, exp(-2 pi i j / L) for j < L / 2, stages in order
+  std::vector<float> twiddle_imag_;
+  std::vector<float> split_real_;  // exp(-2 pi i k / N) for k <= N / 2
+  std::vector<float> split_imag_;
+
+  std::vector<float> real_;
+  std::vector<float> imag_;
+};
+
+}  // namespace shen
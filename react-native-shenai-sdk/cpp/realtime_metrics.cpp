@@ -0,0 +1,82 @@
+#include "realtime_metrics.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace shen {
+
+bool SameMetrics(const realtime_metrics_sample& a, const realtime_metrics_sample& b) {
+  return a.heart_rate_bpm == b.heart_rate_bpm && a.hrv_sdnn_ms == b.hrv_sdnn_ms &&
+         a.hrv_lnrmssd_ms == b.hrv_lnrmssd_ms && a.cardiac_stress == b.cardiac_stress &&
+         a.breathing_rate_bpm == b.breathing_rate_bpm;
+}
+
+realtime_metrics_subscription::realtime_metrics_subscription(std::size_t capacity, callback on_sample)
+    : ring_(on_sample ? 1 : capacity), on_sample_(std::move(on_sample)) {}
+
+void realtime_metrics_subscription::Deliver(const realtime_metrics_sample& sample) {
+  if (on_sample_) {
+    on_sample_(sample);
+  } else if (!ring_.TryPush(sample)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+std::shared_ptr<realtime_metrics_subscription> realtime_metrics_publisher::Subscribe(std::size_t capacity) {
+  return Add(std::make_shared<realtime_metrics_subscription>(capacity));
+}
+
+std::shared_ptr<realtime_metrics_subscription> realtime_metrics_publisher::Subscribe(
+    realtime_metrics_subscription::callback on_sample) {
+  return Add(std::make_shared<realtime_metrics_subscription>(1, std::move(on_sample)));
+}
+
+std::shared_ptr<realtime_metrics_subscription> realtime_metrics_publisher::Add(
+    std::shared_ptr<realtime_metrics_subscription> subscription) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  resumed_ = resumed_ || subscriptions_.empty();
+  subscriptions_.push_back(subscription);
+  subscription_count_.store(subscriptions_.size(), std::memory_order_relaxed);
+  subscriptions_changed_.store(true, std::memory_order_release);
+  return subscription;
+}
+
+void realtime_metrics_publisher::Unsubscribe(const std::shared_ptr<realtime_metrics_subscription>& subscription) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  subscriptions_.erase(std::remove(subscriptions_.begin(), subscriptions_.end(), subscription), subscriptions_.end());
+  subscription_count_.store(subscriptions_.size(), std::memory_order_relaxed);
+  subscriptions_changed_.store(true, std::memory_order_release);
+}
+
+bool realtime_metrics_publisher::Publish(const realtime_metrics_sample& sample) {
+  if (subscriptions_changed_.exchange(false, std::memory_order_acquire)) {
+    std::vector<std::shared_ptr<realtime_metrics_subscription>> previous;
+    bool resumed = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      previous.swap(active_);
+      active_ = subscriptions_;
+      std::swap(resumed, resumed_);
+    }
+    if (resumed) {
+      // Sources are not polled while nobody subscribes, so the last published values may be stale.
+      last_.reset();
+    }
+    // New subscribers start from the current values rather than waiting for the next change.
+    for (const auto& subscription : active_) {
+      if (last_ && std::find(previous.begin(), previous.end(), subscription) == previous.end()) {
+        subscription->Deliver(*last_);
+      }
+    }
+  }
+  if (last_ && SameMetrics(*last_, sample)) {
+    return false;
+  }
+  last_ = sample;
+  for (const auto& subscription : active_) {
+    subscription->Deliver(sample);
+  }
+  return true;
+}
+
+}  // namespace shen
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "realtime_poller.h"
+#include "span.h"
+#include "spsc_ring.h"
+
+namespace shen {
+
+/**
+ * One sample of the realtime metrics.
+ */
+struct realtime_metrics_sample {
+  double timestamp_sec;                      // see GetRealtimeTimestamp()
+  std::optional<double> heart_rate_bpm;      // GetRealtimeHeartRate
+  std::optional<double> hrv_sdnn_ms;         // GetRealtimeHrvSdnn
+  std::optional<double> hrv_lnrmssd_ms;      // only with a metrics period, see realtime_metrics_source
+  std::optional<double> cardiac_stress;      // GetRealtimeCardiacStress
+  std::optional<double> breathing_rate_bpm;  // only with a metrics period, see realtime_metrics_source
+};
+
+/**
+ * Checks whether two samples carry the same metric values, ignoring the timestamps.
+ */
+bool SameMetrics(const realtime_metrics_sample& a, const realtime_metrics_sample& b);
+
+/**
+ * A subscriber's queue of realtime metrics samples.
+ * The publisher pushes into it without locking; the subscriber drains it from a single thread of its choice. When the
+ * subscriber falls behind and the queue is full, new samples are dropped and counted.
+ */
+class realtime_metrics_subscription {
+ public:
+  using callback = std::function<void(const realtime_metrics_sample&)>;
+
+  explicit realtime_metrics_subscription(std::size_t capacity, callback on_sample = nullptr);
+
+  /**
+   * Takes the oldest queued sample.
+   * @return False if no sample is queued.
+   */
+  bool TryPop(realtime_metrics_sample& sample) { return ring_.TryPop(sample); }
+
+  /**
+   * Takes up to `samples.size()` of the oldest queued samples into `samples`.
+   * @return The number of samples taken.
+   */
+  std::size_t Drain(span<realtime_metrics_sample> samples) { return ring_.Pop(samples); }
+
+  /**
+   * Gets the number of samples dropped because the queue was full.
+   */
+  std::uint64_t GetDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  friend class realtime_metrics_publisher;
+
+  void Deliver(const realtime_metrics_sample& sample);
+
+  spsc_ring<realtime_metrics_sample> ring_;
+  callback on_sample_;
+  std::atomic<std::uint64_t> dropped_{0};
+};
+
+/**
+ * Publishes realtime metrics samples to subscribers whenever they change: a sample is pushed to every subscription
+ * only when a value differs from the last published one. Publishing takes no lock unless the set of subscriptions has
+ * changed. Samples come from a realtime_metrics_source, or from any other producer calling Publish.
+ */
+class realtime_metrics_publisher {
+ public:
+  static constexpr std::size_t kDefaultSubscriptionCapacity = 256;
+
+  /**
+   * Subscribes with a queue drained by the caller.
+   */
+  std::shared_ptr<realtime_metrics_subscription> Subscribe(std::size_t capacity = kDefaultSubscriptionCapacity);
+
+  /**
+   * Subscribes with a callback, invoked on the publishing thread for every sample; it must return quickly.
+   */
+  std::shared_ptr<realtime_metrics_subscription> Subscribe(realtime_metrics_subscription::callback on_sample);
+
+  /**
+   * Removes a subscription; the publisher stops delivering to it at its next publish.
+   * @note Does not wait for a delivery in progress on the publishing thread: a callback may still run once after
+   * Unsubscribe returns, so whatever it uses must stay valid until the next publish. The subscription itself is kept
+   * alive by the publisher until then.
+   */
+  void Unsubscribe(const std::shared_ptr<realtime_metrics_subscription>& subscription);
+
+  /**
+   * Checks whether at least one subscription is registered. Safe to call from any thread.
+   */
+  bool HasSubscriptions() const { return subscription_count_.load(std::memory_order_relaxed) != 0; }
+
+  /**
+   * Delivers `sample` to every subscription if its values differ from the last published sample.
+   * @note Producer side: must only be called from one thread at a time, normally a realtime_metrics_source's Poll.
+   * @return True if the sample was delivered.
+   */
+  bool Publish(const realtime_metrics_sample& sample);
+
+ private:
+  std::shared_ptr<realtime_metrics_subscription> Add(std::shared_ptr<realtime_metrics_subscription> subscription);
+
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<realtime_metrics_subscription>> subscriptions_;
+  std::atomic<bool> subscriptions_changed_{false};
+  std::atomic<std::size_t> subscription_count_{0};
+  bool resumed_{false};  // the first subscription since the publisher went idle was added; guarded by mutex_
+
+  // Producer-side state.
+  std::vector<std::shared_ptr<realtime_metrics_subscription>> active_;
+  std::optional<realtime_metrics_sample> last_;
+};
+
+/**
+ * Reads the realtime metrics from the SDK and hands them to a realtime_metrics_publisher.
+ * Registered with a realtime_poller, it reads GetRealtimeHeartRate, GetRealtimeHrvSdnn and GetRealtimeCardiacStress,
+ * or GetRealtimeMetrics(period_sec) if a period is set, on each poll while the publisher has subscriptions.
+ */
+class realtime_metrics_source : public realtime_source {
+ public:
+  /**
+   * Creates the source.
+   * @param publisher The publisher the samples are handed to; must outlive this object.
+   * @param period_sec If set, the metrics are taken from GetRealtimeMetrics(period_sec), which also provides lnRMSSD
+   * and the breathing rate.
+   */
+  explicit realtime_metrics_source(realtime_metrics_publisher& publisher,
+                                   std::optional<float> period_sec = std::nullopt);
+
+  void Poll(double timestamp_sec) override;
+  bool IsActive() const override { return publisher_.HasSubscriptions(); }
+
+ private:
+  realtime_metrics_publisher& publisher_;
+  std::optional<float> period_sec_;
+};
+
+}  // namespace shen
@@ -0,0 +1,38 @@
+#include "realtime_metrics.h"
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+namespace shen {
+
+namespace {
+
+template <typename T>
+std::optional<double> ToDouble(const std::optional<T>& value) {
+  return value ? std::optional<double>(static_cast<double>(*value)) : std::nullopt;
+}
+
+}  // namespace
+
+realtime_metrics_source::realtime_metrics_source(realtime_metrics_publisher& publisher,
+                                                 std::optional<float> period_sec)
+    : publisher_(publisher), period_sec_(period_sec) {}
+
+void realtime_metrics_source::Poll(double timestamp_sec) {
+  realtime_metrics_sample sample{timestamp_sec, {}, {}, {}, {}, {}};
+  if (period_sec_) {
+    if (const auto metrics = GetRealtimeMetrics(*period_sec_)) {
+      sample.heart_rate_bpm = metrics->heart_rate_bpm;
+      sample.hrv_sdnn_ms = metrics->hrv_sdnn_ms;
+      sample.hrv_lnrmssd_ms = metrics->hrv_lnrmssd_ms;
+      sample.cardiac_stress = metrics->stress_index;
+      sample.breathing_rate_bpm = metrics->breathing_rate_bpm;
+    }
+  } else {
+    sample.heart_rate_bpm = ToDouble(GetRealtimeHeartRate());
+    sample.hrv_sdnn_ms = GetRealtimeHrvSdnn();
+    sample.cardiac_stress = GetRealtimeCardiacStress();
+  }
+  publisher_.Publish(sample);
+}
+
+}  // namespace shen
@@ -0,0 +1,63 @@
+#include "realtime_poller.h"
+
+#include <algorithm>
+
+namespace shen {
+
+double GetRealtimeTimestamp() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+realtime_poller::realtime_poller(std::chrono::milliseconds interval)
+    : interval_(std::max(interval, std::chrono::milliseconds(1))) {}
+
+realtime_poller::~realtime_poller() { Stop(); }
+
+void realtime_poller::AddSource(realtime_source& source) { sources_.push_back(&source); }
+
+void realtime_poller::Start() {
+  if (thread_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = false;
+  }
+  thread_ = std::thread([this] { Run(); });
+}
+
+void realtime_poller::Stop() {
+  if (!thread_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  thread_.join();
+}
+
+void realtime_poller::Run() {
+  auto next = std::chrono::steady_clock::now();
+  for (;;) {
+    const double timestamp = GetRealtimeTimestamp();
+    for (auto* source : sources_) {
+      if (source->IsActive()) {
+        source->Poll(timestamp);
+      }
+    }
+
+    // Fixed rate rather than fixed delay, skipping ticks that were missed.
+    const auto now = std::chrono::steady_clock::now();
+    do {
+      next += interval_;
+    } while (next <= now);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (wake_.wait_until(lock, next, [this] { return stop_; })) {
+      return;
+    }
+  }
+}
+
+}  // namespace shen
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace shen {
+
+/**
+ * Gets the timestamp attached to realtime samples: seconds on the steady clock.
+ */
+double GetRealtimeTimestamp();
+
+/**
+ * Something that samples SDK state on the realtime_poller thread.
+ */
+class realtime_source {
+ public:
+  virtual ~realtime_source() = default;
+
+  /**
+   * Samples the SDK and publishes whatever changed. Always called from the same thread.
+   * @param timestamp_sec The time of the poll, see GetRealtimeTimestamp().
+   */
+  virtual void Poll(double timestamp_sec) = 0;
+
+  /**
+   * Checks whether anything consumes the source's samples. Inactive sources are skipped by the poller, so the SDK is
+   * not read on their behalf. Called from the polling thread.
+   */
+  virtual bool IsActive() const { return true; }
+};
+
+/**
+ * Background thread that polls the realtime SDK getters at a fixed interval on behalf of all consumers and hands the
+ * results to the registered sources, which publish them to their subscribers. Consumers then react to pushed changes
+ * instead of each polling the SDK themselves. Only active sources are polled, so a source with no subscribers costs
+ * no SDK calls.
+ *
+ * The poller is a native building block: the React Native bridge does not use it, and the JS API keeps reading the
+ * SDK getters on each call.
+ */
+class realtime_poller {
+ public:
+  // About one camera frame at 30 fps.
+  static constexpr std::chrono::milliseconds kDefaultInterval{33};
+
+  explicit realtime_poller(std::chrono::milliseconds interval = kDefaultInterval);
+  ~realtime_poller();
+
+  realtime_poller(const realtime_poller&) = delete;
+  realtime_poller& operator=(const realtime_poller&) = delete;
+
+  /**
+   * Registers a source, polled in registration order. The source must outlive the poller.
+   * @note Must be called while the poller is stopped.
+   */
+  void AddSource(realtime_source& source);
+
+  /**
+   * Starts the polling thread; does nothing if it is already running.
+   */
+  void Start();
+
+  /**
+   * Stops the polling thread and waits for it to exit; does nothing if it is not running.
+   */
+  void Stop();
+
+  bool IsRunning() const { return thread_.joinable(); }
+
+ private:
+  void Run();
+
+  std::chrono::milliseconds interval_;
+  std::vector<realtime_source*> sources_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stop_{false};
+  std::thread thread_;
+};
+
+}  // namespace shen
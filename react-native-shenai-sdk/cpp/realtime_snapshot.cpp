@@ -0,0 +1,40 @@
+#include "realtime_snapshot.h"
+
+#include <type_traits>
+
+namespace shen {
+
+static_assert(std::is_trivially_copyable_v<realtime_snapshot>, "realtime_snapshot must stay trivially copyable");
+
+realtime_snapshot CaptureRealtimeSnapshot(double timestamp_sec, std::uint64_t sequence) {
+  realtime_snapshot snapshot{};
+  snapshot.timestamp_sec = timestamp_sec;
+  snapshot.sequence = sequence;
+
+  snapshot.face_state = GetFaceState();
+  if (const auto bbox = GetNormalizedFaceBbox()) {
+    snapshot.has_face_bbox = true;
+    snapshot.face_bbox = *bbox;
+  }
+  if (const auto pose = GetFacePose()) {
+    snapshot.has_face_pose = true;
+    snapshot.pose = *pose;
+  }
+
+  snapshot.measurement_state = GetMeasurementState();
+  snapshot.measurement_progress_percentage = GetMeasurementProgressPercentage();
+
+  if (const auto heart_rate = GetRealtimeHeartRate()) {
+    snapshot.has_heart_rate = true;
+    snapshot.heart_rate_bpm = *heart_rate;
+  }
+  snapshot.signal_quality = GetCurrentSignalQualityMetric();
+  snapshot.total_bad_signal_seconds = GetTotalBadSignalSeconds();
+  return snapshot;
+}
+
+void realtime_snapshot_publisher::Poll(double timestamp_sec) {
+  snapshot_.Store(CaptureRealtimeSnapshot(timestamp_sec, ++captures_));
+}
+
+}  // namespace shen
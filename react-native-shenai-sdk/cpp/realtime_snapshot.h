@@ -0,0 +1,79 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "realtime_poller.h"
+#include "seqlock.h"
+
+namespace shen {
+
+/**
+ * The per-frame state a scanner screen shows, in one trivially copyable struct. Optional values come with a `has_`
+ * flag instead of std::optional.
+ */
+struct realtime_snapshot {
+  double timestamp_sec;   // time of the capture, see GetRealtimeTimestamp()
+  std::uint64_t sequence;  // number of the capture; 0 until the first one
+
+  FaceState face_state;
+  bool has_face_bbox;
+  NormalizedFaceBbox face_bbox;
+  bool has_face_pose;
+  face_pose pose;
+
+  MeasurementState measurement_state;
+  float measurement_progress_percentage;
+
+  bool has_heart_rate;
+  int heart_rate_bpm;    // GetRealtimeHeartRate
+  float signal_quality;  // GetCurrentSignalQualityMetric
+  float total_bad_signal_seconds;
+};
+
+/**
+ * Reads GetFaceState, GetNormalizedFaceBbox, GetFacePose, GetMeasurementState, GetMeasurementProgressPercentage,
+ * GetRealtimeHeartRate, GetCurrentSignalQualityMetric and GetTotalBadSignalSeconds back to back.
+ * @param timestamp_sec The timestamp to store in the snapshot.
+ * @param sequence The capture number to store in the snapshot.
+ */
+realtime_snapshot CaptureRealtimeSnapshot(double timestamp_sec, std::uint64_t sequence);
+
+/**
+ * Keeps the latest realtime snapshot. Registered with a realtime_poller, it captures a snapshot once per poll; every
+ * reader then gets that same capture with a single call, instead of crossing into the SDK once per field and mixing
+ * fields from different frames. The snapshot is published through a seqlock, so UI and bridge threads reading it never
+ * block the polling thread, and never wait on it beyond the copy of one snapshot.
+ *
+ * Snapshots are only captured while readers are registered with AddReader; otherwise the latest snapshot goes stale.
+ */
+class realtime_snapshot_publisher : public realtime_source {
+ public:
+  void Poll(double timestamp_sec) override;
+  bool IsActive() const override { return readers_.load(std::memory_order_relaxed) != 0; }
+
+  /**
+   * Registers a reader, making the publisher active. Safe to call from any thread.
+   */
+  void AddReader() { readers_.fetch_add(1, std::memory_order_relaxed); }
+
+  /**
+   * Removes a reader registered with AddReader; capturing stops with the last one. Safe to call from any thread.
+   */
+  void RemoveReader() { readers_.fetch_sub(1, std::memory_order_relaxed); }
+
+  /**
+   * Gets the latest snapshot; its `sequence` is 0 until the first poll.
+   */
+  realtime_snapshot GetRealtimeSnapshot() const { return snapshot_.Load(); }
+
+ private:
+  std::uint64_t captures_{0};  // producer side
+  seqlock<realtime_snapshot> snapshot_;
+  std::atomic<std::size_t> readers_{0};
+};
+
+}  // namespace shen
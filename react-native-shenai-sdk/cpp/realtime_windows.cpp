@@ -0,0 +1,178 @@
+#include "realtime_windows.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <type_traits>
+
+#include "seqlock.h"
+
+namespace shen {
+
+static_assert(std::is_trivially_copyable_v<realtime_window_metrics>,
+              "realtime_window_metrics is published through a seqlock");
+
+struct realtime_windows::window {
+  struct beat {
+    double end_sec;
+    std::int64_t duration_ms;
+  };
+
+  explicit window(float period) : period_sec(period) {}
+
+  void Clear() {
+    beats.clear();
+    minima.clear();
+    maxima.clear();
+    histogram.fill(0);
+    sum = 0;
+    sum_squares = 0;
+    sum_successive_squares = 0;
+    changed = true;
+  }
+
+  void Push(double end_sec, std::int64_t duration_ms) {
+    if (!beats.empty()) {
+      const std::int64_t difference = duration_ms - beats.back().duration_ms;
+      sum_successive_squares += difference * difference;
+    }
+    beats.push_back({end_sec, duration_ms});
+    sum += duration_ms;
+    sum_squares += duration_ms * duration_ms;
+    ++histogram[Bin(duration_ms)];
+    while (!minima.empty() && minima.back() > duration_ms) {
+      minima.pop_back();
+    }
+    minima.push_back(duration_ms);
+    while (!maxima.empty() && maxima.back() < duration_ms) {
+      maxima.pop_back();
+    }
+    maxima.push_back(duration_ms);
+
+    // The newest beat always stays, even in a window shorter than a beat.
+    while (beats.size() > 1 && beats.front().end_sec <= end_sec - period_sec) {
+      Pop();
+    }
+    changed = true;
+  }
+
+  void Pop() {
+    const std::int64_t duration_ms = beats.front().duration_ms;
+    beats.pop_front();
+    if (!beats.empty()) {
+      const std::int64_t difference = beats.front().duration_ms - duration_ms;
+      sum_successive_squares -= difference * difference;
+    }
+    sum -= duration_ms;
+    sum_squares -= duration_ms * duration_ms;
+    --histogram[Bin(duration_ms)];
+    if (minima.front() == duration_ms) {
+      minima.pop_front();
+    }
+    if (maxima.front() == duration_ms) {
+      maxima.pop_front();
+    }
+  }
+
+  realtime_window_metrics Compute() const {
+    realtime_window_metrics result{};
+    result.beat_count = static_cast<std::uint32_t>(beats.size());
+    if (beats.empty()) {
+      return result;
+    }
+    result.end_sec = beats.back().end_sec;
+    const auto n = static_cast<double>(beats.size());
+    const double mean_ms = static_cast<double>(sum) / n;
+    if (mean_ms > 0.0) {
+      result.heart_rate_bpm = 60000.0 / mean_ms;
+    }
+    if (beats.size() < 2) {
+      return result;
+    }
+    // The sums are exact integers, so the variance does not suffer from cancellation drift.
+    const double variance = (static_cast<double>(sum_squares) - static_cast<double>(sum) * mean_ms) / (n - 1.0);
+    result.hrv_sdnn_ms = std::sqrt(std::max(variance, 0.0));
+    if (sum_successive_squares > 0) {
+      result.hrv_lnrmssd_ms = std::log(std::sqrt(static_cast<double>(sum_successive_squares) / (n - 1.0)));
+    }
+
+    // Baevsky: SI = AMo / (2 Mo MxDMn), with AMo in % of beats, and the mode Mo and range MxDMn in seconds.
+    const std::int64_t range_ms = maxima.front() - minima.front();
+    if (range_ms > 0) {
+      const auto mode = static_cast<std::size_t>(std::max_element(histogram.begin(), histogram.end()) -
+                                                 histogram.begin());
+      const double mode_sec = (static_cast<double>(mode) + 0.5) * static_cast<double>(kHistogramBinMs) / 1000.0;
+      const double amplitude_percent = 100.0 * static_cast<double>(histogram[mode]) / n;
+      result.stress_index = amplitude_percent / (2.0 * mode_sec * static_cast<double>(range_ms) / 1000.0);
+    }
+    return result;
+  }
+
+  static std::size_t Bin(std::int64_t duration_ms) {
+    return std::min(static_cast<std::size_t>(std::max<std::int64_t>(duration_ms, 0) / kHistogramBinMs),
+                    kHistogramBinCount - 1);
+  }
+
+  float period_sec;
+  std::deque<beat> beats;
+  std::deque<std::int64_t> minima;  // increasing; the front is the window minimum
+  std::deque<std::int64_t> maxima;  // decreasing; the front is the window maximum
+  std::array<std::uint32_t, kHistogramBinCount> histogram{};
+  // Durations are whole milliseconds, so the sums stay exact.
+  std::int64_t sum{0};
+  std::int64_t sum_squares{0};
+  std::int64_t sum_successive_squares{0};
+  bool changed{false};
+
+  seqlock<realtime_window_metrics> metrics;
+};
+
+realtime_windows::realtime_windows(const heartbeat_stream& stream, const std::vector<float>& periods_sec)
+    : stream_(stream) {
+  windows_.reserve(periods_sec.size());
+  for (const float period : periods_sec) {
+    windows_.push_back(std::make_unique<window>(period));
+  }
+  stream_.AddReader();
+}
+
+realtime_windows::~realtime_windows() { stream_.RemoveReader(); }
+
+float realtime_windows::GetPeriodSec(std::size_t index) const { return windows_[index]->period_sec; }
+
+void realtime_windows::Poll(double /*timestamp_sec*/) {
+  constexpr std::size_t kBatchSize = 64;
+  std::array<heartbeat, kBatchSize> batch;
+  std::size_t count;
+  while ((count = stream_.Read(cursor_, batch)) != 0) {
+    Add(span<const heartbeat>(batch.data(), count));
+  }
+}
+
+void realtime_windows::Add(span<const heartbeat> beats) {
+  for (const heartbeat& beat : beats) {
+    if (beat.end_location_sec < last_end_sec_) {
+      for (const auto& current : windows_) {
+        current->Clear();
+      }
+    }
+    last_end_sec_ = beat.end_location_sec;
+    const auto duration_ms = static_cast<std::int64_t>(std::llround(beat.duration_ms));
+    for (const auto& current : windows_) {
+      current->Push(beat.end_location_sec, duration_ms);
+    }
+  }
+  for (const auto& current : windows_) {
+    if (current->changed) {
+      current->metrics.Store(current->Compute());
+      current->changed = false;
+    }
+  }
+}
+
+realtime_window_metrics realtime_windows::GetMetrics(std::size_t index) const {
+  return windows_[index]->metrics.Load();
+}
+
+}  // namespace shen
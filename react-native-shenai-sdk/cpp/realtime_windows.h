@@ -0,0 +1,86 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "heartbeat_stream.h"
+#include "realtime_poller.h"
+#include "span.h"
+
+namespace shen {
+
+/**
+ * The beat-interval metrics over one sliding window of heartbeats.
+ */
+struct realtime_window_metrics {
+  double end_sec;                        // end location of the newest beat in the window
+  std::uint32_t beat_count;              // beats in the window
+  std::optional<double> heart_rate_bpm;  // 60000 / mean beat duration
+  std::optional<double> hrv_sdnn_ms;     // standard deviation of the beat durations; needs 2 beats
+  std::optional<double> hrv_lnrmssd_ms;  // natural log of the RMS of successive differences; needs 2 beats
+  std::optional<double> stress_index;    // Baevsky stress index; needs 2 beats of different durations
+};
+
+/**
+ * HR, HRV and stress index over several sliding windows of heartbeats at once, e.g. 4, 10, 30 and 60 seconds.
+ *
+ * Each window keeps the durations of its beats together with running sums, the sum of squares, the sum of squared
+ * successive differences, a histogram and running minimum and maximum, so a new beat updates every window in constant
+ * amortized time instead of recomputing it. Registered with a realtime_poller after the heartbeat_stream it reads
+ * from, it follows that stream with its own cursor and updates the windows on each poll; it is a reader of the
+ * stream for its whole lifetime. The metrics of each window are published through a seqlock, so GetMetrics is O(1)
+ * and never blocks the polling thread.
+ *
+ * The metrics are this library's own formulas over the SDK's beats, not the SDK's: values are not rounded, the stress
+ * index takes its mode from a histogram of kHistogramBinMs bins, and windows hold the beats ending within the period.
+ * They will not match GetRealtimeMetrics(period_sec) for the same period, and should not be shown next to it.
+ */
+class realtime_windows : public realtime_source {
+ public:
+  // Bin width of the beat duration histogram behind the stress index mode.
+  static constexpr std::int64_t kHistogramBinMs = 50;
+  // Durations beyond the histogram range are counted in its last bin.
+  static constexpr std::size_t kHistogramBinCount = 40;
+
+  /**
+   * Creates the windows.
+   * @param stream The stream whose beats feed the windows; must outlive this object.
+   * @param periods_sec The length in seconds of each window, in the order of their indices.
+   */
+  realtime_windows(const heartbeat_stream& stream, const std::vector<float>& periods_sec);
+  ~realtime_windows() override;
+
+  std::size_t GetWindowCount() const { return windows_.size(); }
+  float GetPeriodSec(std::size_t index) const;
+
+  void Poll(double timestamp_sec) override;
+
+  /**
+   * Adds `beats` (ordered by location) to every window, evicting the beats that fall out of them, and publishes the
+   * updated metrics. A beat that ends before the previous one starts a new measurement and clears the windows. Polling
+   * calls this with the new beats of the stream.
+   * @note Producer side: must only be called from one thread at a time.
+   */
+  void Add(span<const heartbeat> beats);
+
+  /**
+   * Gets the latest metrics of the window at `index`. Safe to call from any thread.
+   */
+  realtime_window_metrics GetMetrics(std::size_t index) const;
+
+ private:
+  struct window;
+
+  const heartbeat_stream& stream_;
+  heartbeat_cursor cursor_{0};
+
+  std::vector<std::unique_ptr<window>> windows_;
+  double last_end_sec_{0.0};
+};
+
+}  // namespace shen
@@ -0,0 +1,23 @@
+#include "risk_envelope.h"
+
+namespace shen {
+
+risk_envelope ComputeRiskEnvelope(const mx::health_risks::RisksFactors& risk_factors) {
+  risk_envelope envelope;
+  envelope.actual = ComputeHealthRisks(risk_factors);
+  envelope.minimal = GetMinimalRisks(risk_factors);
+  envelope.maximal = GetMaximalRisks(risk_factors);
+  envelope.reference = GetReferenceRisks(risk_factors);
+  return envelope;
+}
+
+risk_envelope ComputeRiskEnvelope(const mx::health_risks::RisksFactors& risk_factors, health_risks_cache& cache) {
+  risk_envelope envelope;
+  envelope.actual = cache.ComputeHealthRisks(risk_factors);
+  envelope.minimal = cache.GetMinimalRisks(risk_factors);
+  envelope.maximal = cache.GetMaximalRisks(risk_factors);
+  envelope.reference = cache.GetReferenceRisks(risk_factors);
+  return envelope;
+}
+
+}  // namespace shen
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include "health_risks_cache.h"
+
+namespace shen {
+
+/**
+ * The actual risks of a patient together with the envelope needed to draw a risk gauge.
+ */
+struct risk_envelope {
+  mx::health_risks::HealthRisks actual;     // ComputeHealthRisks
+  mx::health_risks::HealthRisks minimal;    // GetMinimalRisks
+  mx::health_risks::HealthRisks maximal;    // GetMaximalRisks
+  mx::health_risks::HealthRisks reference;  // GetReferenceRisks
+};
+
+/**
+ * Computes the actual, minimal, maximal and reference risks for the provided factors in a single call.
+ * The four results are computed on the calling thread, so the call is safe from inside a thread_pool task.
+ * @return The risk envelope.
+ */
+risk_envelope ComputeRiskEnvelope(const mx::health_risks::RisksFactors& risk_factors);
+
+/**
+ * Computes the risk envelope on the calling thread, serving each of the four results from `cache` when possible, so
+ * repeated calls for the same factors cost hash lookups instead of model evaluations.
+ * @return The risk envelope.
+ */
+risk_envelope ComputeRiskEnvelope(const mx::health_risks::RisksFactors& risk_factors, health_risks_cache& cache);
+
+}  // namespace shen
@@ -0,0 +1,98 @@
+#include "risk_factor.h"
+
+namespace shen {
+
+bool HasRiskFactor(const mx::health_risks::RisksFactors& f, RiskFactor factor) {
+  switch (factor) {
+    case RiskFactor::Age:
+      return f.age.has_value();
+    case RiskFactor::Cholesterol:
+      return f.cholesterol.has_value();
+    case RiskFactor::CholesterolHdl:
+      return f.cholesterol_hdl.has_value();
+    case RiskFactor::Sbp:
+      return f.sbp.has_value();
+    case RiskFactor::Dbp:
+      return f.dbp.has_value();
+    case RiskFactor::IsSmoker:
+      return f.is_smoker.has_value();
+    case RiskFactor::HypertensionTreatment:
+      return f.hypertension_treatment.has_value();
+    case RiskFactor::HasDiabetes:
+      return f.has_diabetes.has_value();
+    case RiskFactor::BodyHeight:
+      return f.body_height.has_value();
+    case RiskFactor::BodyWeight:
+      return f.body_weight.has_value();
+    case RiskFactor::WaistCircumference:
+      return f.waist_circumference.has_value();
+    case RiskFactor::PhysicalActivity:
+      return f.physical_activity.has_value();
+    case RiskFactor::Gender:
+      return f.gender.has_value();
+    case RiskFactor::Country:
+      return !f.country.empty();
+    case RiskFactor::Race:
+      return f.race.has_value();
+    case RiskFactor::ParentalHypertension:
+      return f.parental_hypertension.has_value();
+    case RiskFactor::FamilyDiabetes:
+      return f.family_diabetes.has_value();
+    case RiskFactor::Triglyceride:
+      return f.triglyceride.has_value();
+    case RiskFactor::FastingGlucose:
+      return f.fasting_glucose.has_value();
+    case RiskFactor::VegetableFruitDiet:
+      return f.vegetable_fruit_diet.has_value();
+    case RiskFactor::HistoryOfHighGlucose:
+      return f.history_of_high_glucose.has_value();
+    case RiskFactor::HistoryOfHypertension:
+      return f.history_of_hypertension.has_value();
+  }
+  return false;
+}
+
+risk_factor_mask GetProvidedRiskFactors(const mx::health_risks::RisksFactors& risk_factors) {
+  risk_factor_mask mask = 0;
+  for (std::size_t i = 0; i < kRiskFactorCount; ++i) {
+    if (HasRiskFactor(risk_factors, static_cast<RiskFactor>(i))) {
+      mask |= RiskFactorBit(static_cast<RiskFactor>(i));
+    }
+  }
+  return mask;
+}
+
+risk_factor_mask GetChangedRiskFactors(const mx::health_risks::RisksFactors& a,
+                                       const mx::health_risks::RisksFactors& b) {
+  risk_factor_mask mask = 0;
+  auto check = [&mask](bool equal, RiskFactor factor) {
+    if (!equal) {
+      mask |= RiskFactorBit(factor);
+    }
+  };
+  check(a.age == b.age, RiskFactor::Age);
+  check(a.cholesterol == b.cholesterol, RiskFactor::Cholesterol);
+  check(a.cholesterol_hdl == b.cholesterol_hdl, RiskFactor::CholesterolHdl);
+  check(a.sbp == b.sbp, RiskFactor::Sbp);
+  check(a.dbp == b.dbp, RiskFactor::Dbp);
+  check(a.is_smoker == b.is_smoker, RiskFactor::IsSmoker);
+  check(a.hypertension_treatment == b.hypertension_treatment, RiskFactor::HypertensionTreatment);
+  check(a.has_diabetes == b.has_diabetes, RiskFactor::HasDiabetes);
+  check(a.body_height == b.body_height, RiskFactor::BodyHeight);
+  check(a.body_weight == b.body_weight, RiskFactor::BodyWeight);
+  check(a.waist_circumference == b.waist_circumference, RiskFactor::WaistCircumference);
+  check(a.physical_activity == b.physical_activity, RiskFactor::PhysicalActivity);
+  check(a.gender == b.gender, RiskFactor::Gender);
+  check(a.country == b.country, RiskFactor::Country);
+  check(a.race == b.race, RiskFactor::Race);
+  check(a.parental_hypertension == b.parental_hypertension, RiskFactor::ParentalHypertension);
+  check(a.family_diabetes == b.family_diabetes, RiskFactor::FamilyDiabetes);
+  check(a.triglyceride == b.triglyceride, RiskFactor::Triglyceride);
+  check(a.fasting_glucose == b.fasting_glucose, RiskFactor::FastingGlucose);
+  check(a.vegetable_fruit_diet == b.vegetable_fruit_diet, RiskFactor::VegetableFruitDiet);
+  check(a.history_of_high_glucose == b.history_of_high_glucose, RiskFactor::HistoryOfHighGlucose);
+  check(a.history_of_hypertension == b.history_of_hypertension, RiskFactor::HistoryOfHypertension);
+  return mask;
+}
+
+}  // namespace shen
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <ShenaiSDK/health_risks_factors.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace shen {
+
+/**
+ * The individual fields of mx::health_risks::RisksFactors, in declaration order.
+ */
+enum class RiskFactor : std::uint8_t {
+  Age = 0,
+  Cholesterol,
+  CholesterolHdl,
+  Sbp,
+  Dbp,
+  IsSmoker,
+  HypertensionTreatment,
+  HasDiabetes,
+  BodyHeight,
+  BodyWeight,
+  WaistCircumference,
+  PhysicalActivity,
+  Gender,
+  Country,
+  Race,
+  ParentalHypertension,
+  FamilyDiabetes,
+  Triglyceride,
+  FastingGlucose,
+  VegetableFruitDiet,
+  HistoryOfHighGlucose,
+  HistoryOfHypertension
+};
+
+constexpr std::size_t kRiskFactorCount = static_cast<std::size_t>(RiskFactor::HistoryOfHypertension) + 1;
+
+/**
+ * Set of risk factors, one bit per RiskFactor.
+ */
+using risk_factor_mask = std::uint32_t;
+
+constexpr risk_factor_mask RiskFactorBit(RiskFactor factor) { return risk_factor_mask{1} << static_cast<int>(factor); }
+
+/**
+ * Checks whether the given factor is provided (non-empty) in `risk_factors`.
+ */
+bool HasRiskFactor(const mx::health_risks::RisksFactors& risk_factors, RiskFactor factor);
+
+/**
+ * Gets the set of factors provided (non-empty) in `risk_factors`.
+ */
+risk_factor_mask GetProvidedRiskFactors(const mx::health_risks::RisksFactors& risk_factors);
+
+/**
+ * Gets the set of factors whose value (or presence) differs between `a` and `b`.
+ */
+risk_factor_mask GetChangedRiskFactors(const mx::health_risks::RisksFactors& a,
+                                       const mx::health_risks::RisksFactors& b);
+
+}  // namespace shen
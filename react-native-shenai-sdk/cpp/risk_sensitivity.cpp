@@ -0,0 +1,122 @@
+#include "risk_sensitivity.h"
+
+#include "health_risks_batch.h"
+
+namespace shen {
+
+namespace {
+
+template <typename T>
+bool Increase(std::optional<T>& value, double step) {
+  if (!value) {
+    return false;
+  }
+  *value = static_cast<T>(*value + step);
+  return true;
+}
+
+bool Flip(std::optional<bool>& value, double& step) {
+  if (!value) {
+    return false;
+  }
+  step = *value ? -1.0 : 1.0;
+  *value = !*value;
+  return true;
+}
+
+// Applies the perturbation of `factor` to `f`; returns false if the factor is missing or cannot be perturbed.
+bool Perturb(mx::health_risks::RisksFactors& f, RiskFactor factor, double& step) {
+  step = GetSensitivityStep(factor);
+  switch (factor) {
+    case RiskFactor::Age:
+      return Increase(f.age, step);
+    case RiskFactor::Cholesterol:
+      return Increase(f.cholesterol, step);
+    case RiskFactor::CholesterolHdl:
+      return Increase(f.cholesterol_hdl, step);
+    case RiskFactor::Sbp:
+      return Increase(f.sbp, step);
+    case RiskFactor::Dbp:
+      return Increase(f.dbp, step);
+    case RiskFactor::BodyHeight:
+      return Increase(f.body_height, step);
+    case RiskFactor::BodyWeight:
+      return Increase(f.body_weight, step);
+    case RiskFactor::WaistCircumference:
+      return Increase(f.waist_circumference, step);
+    case RiskFactor::Triglyceride:
+      return Increase(f.triglyceride, step);
+    case RiskFactor::FastingGlucose:
+      return Increase(f.fasting_glucose, step);
+    case RiskFactor::IsSmoker:
+      return Flip(f.is_smoker, step);
+    case RiskFactor::HasDiabetes:
+      return Flip(f.has_diabetes, step);
+    case RiskFactor::VegetableFruitDiet:
+      return Flip(f.vegetable_fruit_diet, step);
+    case RiskFactor::HistoryOfHighGlucose:
+      return Flip(f.history_of_high_glucose, step);
+    case RiskFactor::HistoryOfHypertension:
+      return Flip(f.history_of_hypertension, step);
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+double GetSensitivityStep(RiskFactor factor) {
+  switch (factor) {
+    case RiskFactor::Age:
+    case RiskFactor::BodyHeight:
+    case RiskFactor::BodyWeight:
+    case RiskFactor::WaistCircumference:
+      return 1.0;
+    case RiskFactor::Cholesterol:
+    case RiskFactor::Triglyceride:
+      return 10.0;
+    case RiskFactor::CholesterolHdl:
+    case RiskFactor::FastingGlucose:
+    case RiskFactor::Sbp:
+    case RiskFactor::Dbp:
+      return 5.0;
+    default:
+      return 0.0;
+  }
+}
+
+risk_sensitivities ComputeRiskSensitivities(const mx::health_risks::RisksFactors& risk_factors,
+                                            risk_factor_mask factors, thread_pool& pool) {
+  std::vector<mx::health_risks::RisksFactors> inputs{risk_factors};
+  std::vector<risk_sensitivity> sensitivities;
+  for (std::size_t i = 0; i < kRiskFactorCount; ++i) {
+    const auto factor = static_cast<RiskFactor>(i);
+    if ((factors & RiskFactorBit(factor)) == 0) {
+      continue;
+    }
+    mx::health_risks::RisksFactors perturbed = risk_factors;
+    double step = 0.0;
+    if (Perturb(perturbed, factor, step)) {
+      inputs.push_back(std::move(perturbed));
+      sensitivities.push_back({factor, step, {}});
+    }
+  }
+
+  std::vector<mx::health_risks::HealthRisks> outputs(inputs.size());
+  if (pool.IsRunningOnCurrentThread()) {
+    // A nested ParallelFor on the same pool cannot run; the enclosing batch already keeps its threads busy.
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+      outputs[i] = ComputeHealthRisks(inputs[i]);
+    }
+  } else {
+    ComputeHealthRisks(inputs, outputs, pool, 1);
+  }
+
+  risk_sensitivities result{std::move(outputs[0]), std::move(sensitivities)};
+  for (std::size_t i = 0; i < result.factors.size(); ++i) {
+    result.factors[i].perturbed = std::move(outputs[i + 1]);
+  }
+  return result;
+}
+
+}  // namespace shen
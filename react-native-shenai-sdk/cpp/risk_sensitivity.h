@@ -0,0 +1,78 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <optional>
+#include <vector>
+
+#include "risk_factor.h"
+#include "thread_pool.h"
+
+namespace shen {
+
+/**
+ * Factors perturbed by default: the numeric factors plus the yes/no factors a patient can change.
+ */
+constexpr risk_factor_mask kSensitivityRiskFactors =
+    RiskFactorBit(RiskFactor::Age) | RiskFactorBit(RiskFactor::Cholesterol) |
+    RiskFactorBit(RiskFactor::CholesterolHdl) | RiskFactorBit(RiskFactor::Sbp) | RiskFactorBit(RiskFactor::Dbp) |
+    RiskFactorBit(RiskFactor::IsSmoker) | RiskFactorBit(RiskFactor::HasDiabetes) |
+    RiskFactorBit(RiskFactor::BodyHeight) | RiskFactorBit(RiskFactor::BodyWeight) |
+    RiskFactorBit(RiskFactor::WaistCircumference) | RiskFactorBit(RiskFactor::Triglyceride) |
+    RiskFactorBit(RiskFactor::FastingGlucose) | RiskFactorBit(RiskFactor::VegetableFruitDiet);
+
+/**
+ * The health risks with a single factor perturbed.
+ */
+struct risk_sensitivity {
+  RiskFactor factor;
+  // Change applied to the factor: a clinically meaningful step for numeric factors (see GetSensitivityStep),
+  // +1 or -1 for yes/no factors that were flipped.
+  double step;
+  mx::health_risks::HealthRisks perturbed;
+};
+
+/**
+ * The health risks of a patient together with their sensitivity to each perturbed factor.
+ */
+struct risk_sensitivities {
+  mx::health_risks::HealthRisks base;
+  std::vector<risk_sensitivity> factors;
+};
+
+/**
+ * Gets the step applied to a numeric factor: 1 year, 10 mg/dL of cholesterol or triglycerides, 5 mg/dL of HDL or
+ * glucose, 5 mmHg, 1 cm or 1 kg. Returns 0 for factors that are not numeric.
+ */
+double GetSensitivityStep(RiskFactor factor);
+
+/**
+ * Computes the health risks together with finite deltas with respect to each of `factors` that is provided in
+ * `risk_factors`. Numeric factors are increased by GetSensitivityStep(factor), yes/no factors are flipped.
+ * The base and all the perturbed evaluations run as one batch on `pool`, so with enough threads the latency is close
+ * to that of a single evaluation. Called from inside a chunk of `pool`, e.g. from a batch over many patients, they run
+ * on the calling thread instead.
+ * @return The base risks and one entry per perturbed factor, in RiskFactor order.
+ */
+risk_sensitivities ComputeRiskSensitivities(const mx::health_risks::RisksFactors& risk_factors,
+                                            risk_factor_mask factors = kSensitivityRiskFactors,
+                                            thread_pool& pool = DefaultThreadPool());
+
+/**
+ * Gets the finite-difference derivative of one risk with respect to the factor of `sensitivity`, i.e. the change of
+ * the risk per unit of the factor.
+ * @param risk Selects the risk, e.g. `[](const HealthRisks& r) { return r.cv_diseases.overall_risk; }`.
+ * @return The derivative, or empty if the risk is unavailable in either evaluation.
+ */
+template <typename Selector>
+std::optional<double> GetDerivative(const risk_sensitivities& sensitivities, const risk_sensitivity& sensitivity,
+                                    Selector risk) {
+  const auto base = risk(sensitivities.base);
+  const auto perturbed = risk(sensitivity.perturbed);
+  if (!base || !perturbed || sensitivity.step == 0.0) {
+    return std::nullopt;
+  }
+  return (static_cast<double>(*perturbed) - static_cast<double>(*base)) / sensitivity.step;
+}
+
+}  // namespace shen
@@ -0,0 +1,26 @@
+#include "risk_session.h"
+
+namespace shen {
+
+risk_session::risk_session(mx::health_risks::RisksFactors risk_factors, health_index_mask watched,
+                           std::size_t cache_capacity)
+    : risk_factors_(std::move(risk_factors)), watched_(watched), cache_(cache_capacity) {
+  if (watched_ != 0) {
+    CopyHealthIndices(cache_.ComputeHealthRisks(risk_factors_), health_risks_, watched_);
+  }
+}
+
+health_index_mask risk_session::SetRisksFactors(const mx::health_risks::RisksFactors& risk_factors) {
+  const risk_factor_mask changed = GetChangedRiskFactors(risk_factors_, risk_factors);
+  if (changed == 0) {
+    return 0;
+  }
+  risk_factors_ = risk_factors;
+  if (watched_ == 0) {
+    return 0;
+  }
+  CopyHealthIndices(cache_.ComputeHealthRisks(risk_factors_), health_risks_, watched_);
+  return watched_;
+}
+
+}  // namespace shen
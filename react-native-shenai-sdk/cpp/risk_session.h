@@ -0,0 +1,74 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <cstddef>
+#include <utility>
+
+#include "health_index.h"
+#include "health_risks_cache.h"
+#include "risk_factor.h"
+
+namespace shen {
+
+/**
+ * Stateful what-if session over the risks of a single patient, e.g. behind a risk factors editor with sliders.
+ * Each update diffs the new factors against the current ones. If no factor changed, no model is evaluated; otherwise
+ * the fields of the watched indices are replaced. Which indices a factor affects is not known for certain, so any
+ * change refreshes all the watched indices. Evaluations go through a small LRU cache, so dragging a slider back over
+ * values seen before costs a lookup.
+ * @note Not thread-safe; meant to be owned by a single (UI) thread.
+ */
+class risk_session {
+ public:
+  static constexpr std::size_t kDefaultCacheCapacity = 256;
+
+  /**
+   * Starts a session, evaluating the risks for `risk_factors` once unless no index is watched.
+   * @param risk_factors The initial risk factors.
+   * @param watched The health indices kept up to date by the session.
+   * @param cache_capacity The number of evaluations memoized by the session.
+   */
+  explicit risk_session(mx::health_risks::RisksFactors risk_factors, health_index_mask watched = kAllHealthIndices,
+                        std::size_t cache_capacity = kDefaultCacheCapacity);
+
+  /**
+   * Gets the current risk factors.
+   */
+  const mx::health_risks::RisksFactors& GetRisksFactors() const { return risk_factors_; }
+
+  /**
+   * Gets the current health risks. Only the fields of the watched indices are set; the others are left empty.
+   */
+  const mx::health_risks::HealthRisks& GetHealthRisks() const { return health_risks_; }
+
+  /**
+   * Gets the health indices kept up to date by the session.
+   */
+  health_index_mask GetWatchedHealthIndices() const { return watched_; }
+
+  /**
+   * Replaces the risk factors.
+   * @return The watched indices that were recomputed; 0 if no factor changed.
+   */
+  health_index_mask SetRisksFactors(const mx::health_risks::RisksFactors& risk_factors);
+
+  /**
+   * Changes a single risk factor, e.g. `session.Set(&RisksFactors::cholesterol, std::optional<float>(210))`.
+   * @return The watched indices that were recomputed; 0 if the value did not change.
+   */
+  template <typename T>
+  health_index_mask Set(T mx::health_risks::RisksFactors::*field, T value) {
+    mx::health_risks::RisksFactors updated = risk_factors_;
+    updated.*field = std::move(value);
+    return SetRisksFactors(updated);
+  }
+
+ private:
+  mx::health_risks::RisksFactors risk_factors_;
+  mx::health_risks::HealthRisks health_risks_;
+  health_index_mask watched_;
+  health_risks_cache cache_;
+};
+
+}  // namespace shen
@@ -0,0 +1,124 @@
+#include "risk_uncertainty.h"
+
+#include <array>
+#include <cmath>
+
+namespace shen {
+
+namespace {
+
+constexpr std::size_t kNoisyFactorCount = 9;
+
+struct noisy_factor {
+  std::optional<float> mx::health_risks::RisksFactors::*field;
+  float sigma;
+};
+
+std::array<noisy_factor, kNoisyFactorCount> NoisyFactors(const risk_factor_noise& noise) {
+  using mx::health_risks::RisksFactors;
+  return {{
+      {&RisksFactors::cholesterol, noise.cholesterol},
+      {&RisksFactors::cholesterol_hdl, noise.cholesterol_hdl},
+      {&RisksFactors::sbp, noise.sbp},
+      {&RisksFactors::dbp, noise.dbp},
+      {&RisksFactors::body_height, noise.body_height},
+      {&RisksFactors::body_weight, noise.body_weight},
+      {&RisksFactors::waist_circumference, noise.waist_circumference},
+      {&RisksFactors::triglyceride, noise.triglyceride},
+      {&RisksFactors::fasting_glucose, noise.fasting_glucose},
+  }};
+}
+
+std::uint64_t SplitMix64(std::uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// xorshift64* generator; one per chunk, so chunks can be sampled independently.
+class random_generator {
+ public:
+  explicit random_generator(std::uint64_t seed) : state_(SplitMix64(seed) | 1) {}
+
+  // Uniform in (0, 1].
+  float NextUniform() {
+    state_ ^= state_ >> 12;
+    state_ ^= state_ << 25;
+    state_ ^= state_ >> 27;
+    return static_cast<float>(((state_ * 0x2545f4914f6cdd1dULL) >> 40) + 1) * (1.0f / 16777216.0f);
+  }
+
+ private:
+  std::uint64_t state_;
+};
+
+// Fills `out` with standard normal variates using the Box-Muller transform. The uniforms are drawn first so that the
+// transform runs as a plain loop over arrays.
+void FillStandardNormal(random_generator& rng, float* out, std::size_t count) {
+  constexpr float kTwoPi = 6.283185307f;
+  const std::size_t pairs = (count + 1) / 2;
+  std::array<float, kRiskSampleChunkSize> u1;
+  std::array<float, kRiskSampleChunkSize> u2;
+  for (std::size_t i = 0; i < pairs; ++i) {
+    u1[i] = rng.NextUniform();
+    u2[i] = rng.NextUniform();
+  }
+  std::array<float, kRiskSampleChunkSize> z;
+  for (std::size_t i = 0; i < pairs; ++i) {
+    const float r = std::sqrt(-2.0f * std::log(u1[i]));
+    z[2 * i] = r * std::cos(kTwoPi * u2[i]);
+    z[2 * i + 1] = r * std::sin(kTwoPi * u2[i]);
+  }
+  std::copy(z.begin(), z.begin() + count, out);
+}
+
+}  // namespace
+
+std::vector<mx::health_risks::HealthRisks> SampleHealthRisks(const mx::health_risks::RisksFactors& risk_factors,
+                                                             const risk_factor_noise& noise, std::size_t count,
+                                                             std::uint64_t seed, thread_pool& pool) {
+  std::array<noisy_factor, kNoisyFactorCount> factors;
+  std::size_t factor_count = 0;
+  for (const auto& factor : NoisyFactors(noise)) {
+    if (factor.sigma > 0 && risk_factors.*factor.field) {
+      factors[factor_count++] = factor;
+    }
+  }
+
+  std::vector<mx::health_risks::HealthRisks> samples(count);
+  auto sample_range = [&](std::size_t begin, std::size_t end) {
+    // One column of sampled values per noisy factor.
+    std::array<std::array<float, kRiskSampleChunkSize>, kNoisyFactorCount> values;
+    mx::health_risks::RisksFactors row = risk_factors;
+    for (std::size_t chunk = begin; chunk < end; chunk += kRiskSampleChunkSize) {
+      random_generator rng(seed ^ SplitMix64(chunk / kRiskSampleChunkSize));
+      const std::size_t n = std::min(end - chunk, kRiskSampleChunkSize);
+      for (std::size_t f = 0; f < factor_count; ++f) {
+        const float mean = *(risk_factors.*factors[f].field);
+        const float sigma = factors[f].sigma;
+        auto& column = values[f];
+        FillStandardNormal(rng, column.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+          column[i] = std::max(0.0f, mean + sigma * column[i]);
+        }
+      }
+
+      for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t f = 0; f < factor_count; ++f) {
+          row.*factors[f].field = values[f][i];
+        }
+        samples[chunk + i] = ComputeHealthRisks(row);
+      }
+    }
+  };
+  if (pool.IsRunningOnCurrentThread()) {
+    // A nested ParallelFor on the same pool cannot run. The chunks are the same, so the samples are too.
+    sample_range(0, count);
+  } else {
+    pool.ParallelFor(count, kRiskSampleChunkSize, sample_range);
+  }
+  return samples;
+}
+
+}  // namespace shen
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "span.h"
+#include "thread_pool.h"
+
+namespace shen {
+
+/**
+ * Standard deviations of the measurement error of each risk factor, in the units of RisksFactors.
+ * A factor with a standard deviation of 0, or one that is not provided, is kept at its measured value.
+ */
+struct risk_factor_noise {
+  float cholesterol{0};
+  float cholesterol_hdl{0};
+  float sbp{0};
+  float dbp{0};
+  float body_height{0};          // centimeters
+  float body_weight{0};          // kilograms
+  float waist_circumference{0};  // centimeters
+  float triglyceride{0};
+  float fasting_glucose{0};
+};
+
+/**
+ * Number of samples evaluated per chunk of work; chunk boundaries are fixed so that a given seed yields the same
+ * samples regardless of the number of threads.
+ */
+constexpr std::size_t kRiskSampleChunkSize = 64;
+
+/**
+ * Samples `count` sets of risk factors around `risk_factors`, with independent normally distributed errors described
+ * by `noise` (clamped at 0), and evaluates their health risks in parallel on `pool`, or on the calling thread when
+ * called from inside a chunk of `pool`.
+ * @return The health risks of every sample, deterministic for a given `seed`.
+ */
+std::vector<mx::health_risks::HealthRisks> SampleHealthRisks(const mx::health_risks::RisksFactors& risk_factors,
+                                                             const risk_factor_noise& noise, std::size_t count,
+                                                             std::uint64_t seed = 0,
+                                                             thread_pool& pool = DefaultThreadPool());
+
+/**
+ * Summary of the distribution of one risk over the samples.
+ */
+struct risk_band {
+  double mean;
+  double lower;  // value at the lower percentile
+  double median;
+  double upper;       // value at the upper percentile
+  std::size_t count;  // number of samples in which the risk was available
+};
+
+/**
+ * Summarizes one risk over the samples returned by SampleHealthRisks.
+ * @param risk Selects the risk, e.g. `[](const HealthRisks& r) { return r.cv_diseases.overall_risk; }`.
+ * @param lower_quantile, upper_quantile Bounds of the band, in [0, 1]; the default is the 90% band.
+ * @return The band, or empty if the risk is unavailable in every sample.
+ */
+template <typename Selector>
+std::optional<risk_band> ComputeRiskBand(span<const mx::health_risks::HealthRisks> samples, Selector risk,
+                                         double lower_quantile = 0.05, double upper_quantile = 0.95) {
+  std::vector<double> values;
+  values.reserve(samples.size());
+  double sum = 0.0;
+  for (const auto& sample : samples) {
+    if (const auto value = risk(sample)) {
+      values.push_back(static_cast<double>(*value));
+      sum += values.back();
+    }
+  }
+  if (values.empty()) {
+    return std::nullopt;
+  }
+
+  auto quantile = [&values](double q) {
+    const auto rank = static_cast<std::size_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+  };
+  risk_band band;
+  band.mean = sum / static_cast<double>(values.size());
+  band.lower = quantile(lower_quantile);
+  band.median = quantile(0.5);
+  band.upper = quantile(upper_quantile);
+  band.count = values.size();
+  return band;
+}
+
+}  // namespace shen
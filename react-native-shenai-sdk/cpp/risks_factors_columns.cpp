@@ -0,0 +1,131 @@
+#include "risks_factors_columns.h"
+
+#include <algorithm>
+#include <optional>
+
+namespace shen {
+
+namespace {
+
+template <typename T, typename U>
+void Store(const std::optional<U>& value, std::vector<T>& column, std::vector<std::uint64_t>& presence,
+           std::size_t i) {
+  if (value) {
+    column[i] = static_cast<T>(*value);
+    presence[i / 64] |= std::uint64_t{1} << (i % 64);
+  } else {
+    column[i] = T{};
+  }
+}
+
+template <typename T, typename U>
+void Load(const risks_factors_columns& columns, RiskFactor factor, const std::vector<T>& column, std::size_t i,
+          std::optional<U>& value) {
+  if (columns.IsPresent(factor, i)) {
+    value = static_cast<U>(column[i]);
+  } else {
+    value.reset();
+  }
+}
+
+}  // namespace
+
+void ToColumns(span<const mx::health_risks::RisksFactors> risk_factors, risks_factors_columns& c) {
+  const std::size_t n = risk_factors.size();
+  c.size = n;
+  c.age.resize(n);
+  c.cholesterol.resize(n);
+  c.cholesterol_hdl.resize(n);
+  c.sbp.resize(n);
+  c.dbp.resize(n);
+  c.is_smoker.resize(n);
+  c.hypertension_treatment.resize(n);
+  c.has_diabetes.resize(n);
+  c.body_height.resize(n);
+  c.body_weight.resize(n);
+  c.waist_circumference.resize(n);
+  c.physical_activity.resize(n);
+  c.gender.resize(n);
+  c.country.resize(n);
+  c.race.resize(n);
+  c.parental_hypertension.resize(n);
+  c.family_diabetes.resize(n);
+  c.triglyceride.resize(n);
+  c.fasting_glucose.resize(n);
+  c.vegetable_fruit_diet.resize(n);
+  c.history_of_high_glucose.resize(n);
+  c.history_of_hypertension.resize(n);
+  for (auto& words : c.presence) {
+    words.assign((n + 63) / 64, 0);
+  }
+  c.other_country.clear();
+
+  auto presence = [&c](RiskFactor factor) -> std::vector<std::uint64_t>& {
+    return c.presence[static_cast<std::size_t>(factor)];
+  };
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto& f = risk_factors[i];
+    Store(f.age, c.age, presence(RiskFactor::Age), i);
+    Store(f.cholesterol, c.cholesterol, presence(RiskFactor::Cholesterol), i);
+    Store(f.cholesterol_hdl, c.cholesterol_hdl, presence(RiskFactor::CholesterolHdl), i);
+    Store(f.sbp, c.sbp, presence(RiskFactor::Sbp), i);
+    Store(f.dbp, c.dbp, presence(RiskFactor::Dbp), i);
+    Store(f.is_smoker, c.is_smoker, presence(RiskFactor::IsSmoker), i);
+    Store(f.hypertension_treatment, c.hypertension_treatment, presence(RiskFactor::HypertensionTreatment), i);
+    Store(f.has_diabetes, c.has_diabetes, presence(RiskFactor::HasDiabetes), i);
+    Store(f.body_height, c.body_height, presence(RiskFactor::BodyHeight), i);
+    Store(f.body_weight, c.body_weight, presence(RiskFactor::BodyWeight), i);
+    Store(f.waist_circumference, c.waist_circumference, presence(RiskFactor::WaistCircumference), i);
+    Store(f.physical_activity, c.physical_activity, presence(RiskFactor::PhysicalActivity), i);
+    Store(f.gender, c.gender, presence(RiskFactor::Gender), i);
+    const std::optional<country_code> country = country_code::FromString(f.country);
+    c.country[i] = country.value_or(country_code());
+    if (!country) {
+      c.other_country.emplace_back(i, f.country);
+    }
+    if (!f.country.empty()) {
+      presence(RiskFactor::Country)[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+    Store(f.race, c.race, presence(RiskFactor::Race), i);
+    Store(f.parental_hypertension, c.parental_hypertension, presence(RiskFactor::ParentalHypertension), i);
+    Store(f.family_diabetes, c.family_diabetes, presence(RiskFactor::FamilyDiabetes), i);
+    Store(f.triglyceride, c.triglyceride, presence(RiskFactor::Triglyceride), i);
+    Store(f.fasting_glucose, c.fasting_glucose, presence(RiskFactor::FastingGlucose), i);
+    Store(f.vegetable_fruit_diet, c.vegetable_fruit_diet, presence(RiskFactor::VegetableFruitDiet), i);
+    Store(f.history_of_high_glucose, c.history_of_high_glucose, presence(RiskFactor::HistoryOfHighGlucose), i);
+    Store(f.history_of_hypertension, c.history_of_hypertension, presence(RiskFactor::HistoryOfHypertension), i);
+  }
+}
+
+void GetRow(const risks_factors_columns& c, std::size_t i, mx::health_risks::RisksFactors& f) {
+  Load(c, RiskFactor::Age, c.age, i, f.age);
+  Load(c, RiskFactor::Cholesterol, c.cholesterol, i, f.cholesterol);
+  Load(c, RiskFactor::CholesterolHdl, c.cholesterol_hdl, i, f.cholesterol_hdl);
+  Load(c, RiskFactor::Sbp, c.sbp, i, f.sbp);
+  Load(c, RiskFactor::Dbp, c.dbp, i, f.dbp);
+  Load(c, RiskFactor::IsSmoker, c.is_smoker, i, f.is_smoker);
+  Load(c, RiskFactor::HypertensionTreatment, c.hypertension_treatment, i, f.hypertension_treatment);
+  Load(c, RiskFactor::HasDiabetes, c.has_diabetes, i, f.has_diabetes);
+  Load(c, RiskFactor::BodyHeight, c.body_height, i, f.body_height);
+  Load(c, RiskFactor::BodyWeight, c.body_weight, i, f.body_weight);
+  Load(c, RiskFactor::WaistCircumference, c.waist_circumference, i, f.waist_circumference);
+  Load(c, RiskFactor::PhysicalActivity, c.physical_activity, i, f.physical_activity);
+  Load(c, RiskFactor::Gender, c.gender, i, f.gender);
+  if (c.country[i].IsEmpty() && c.IsPresent(RiskFactor::Country, i)) {
+    const auto it = std::lower_bound(c.other_country.begin(), c.other_country.end(), i,
+                                     [](const auto& entry, std::size_t record) { return entry.first < record; });
+    f.country = it->second;
+  } else {
+    c.country[i].AssignTo(f.country);
+  }
+  Load(c, RiskFactor::Race, c.race, i, f.race);
+  Load(c, RiskFactor::ParentalHypertension, c.parental_hypertension, i, f.parental_hypertension);
+  Load(c, RiskFactor::FamilyDiabetes, c.family_diabetes, i, f.family_diabetes);
+  Load(c, RiskFactor::Triglyceride, c.triglyceride, i, f.triglyceride);
+  Load(c, RiskFactor::FastingGlucose, c.fasting_glucose, i, f.fasting_glucose);
+  Load(c, RiskFactor::VegetableFruitDiet, c.vegetable_fruit_diet, i, f.vegetable_fruit_diet);
+  Load(c, RiskFactor::HistoryOfHighGlucose, c.history_of_high_glucose, i, f.history_of_high_glucose);
+  Load(c, RiskFactor::HistoryOfHypertension, c.history_of_hypertension, i, f.history_of_hypertension);
+}
+
+}  // namespace shen
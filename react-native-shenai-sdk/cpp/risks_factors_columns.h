@@ -0,0 +1,75 @@
+#pragma once
+
+#include <ShenaiSDK/shenai_api_cpp.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "country_code.h"
+#include "risk_factor.h"
+#include "span.h"
+
+namespace shen {
+
+/**
+ * Columnar (structure-of-arrays) storage of a cohort of mx::health_risks::RisksFactors.
+ * Each factor is kept in its own contiguous array, indexed by record. Whether a record provides a factor is kept in
+ * a per-factor presence bitmask: bit (i % 64) of word (i / 64) is set when record i has the factor. The value stored
+ * for a missing factor is value-initialized and must be ignored.
+ *
+ * This is a storage format only. The SDK evaluates one RisksFactors at a time, so evaluating a stored cohort means
+ * rebuilding rows with GetRow (or keeping the rows) and going through the span overload of ComputeHealthRisks.
+ */
+struct risks_factors_columns {
+  std::size_t size{0};
+
+  std::vector<int> age;
+  std::vector<float> cholesterol;
+  std::vector<float> cholesterol_hdl;
+  std::vector<float> sbp;
+  std::vector<float> dbp;
+  std::vector<std::uint8_t> is_smoker;
+  std::vector<mx::health_risks::HypertensionTreatment> hypertension_treatment;
+  std::vector<std::uint8_t> has_diabetes;
+  std::vector<float> body_height;          // centimeters
+  std::vector<float> body_weight;          // kilograms
+  std::vector<float> waist_circumference;  // centimeters
+  std::vector<mx::health_risks::PhysicalActivity> physical_activity;
+  std::vector<mx::health_risks::Gender> gender;
+  std::vector<country_code> country;  // empty for a country without country_code representation, see other_country
+  std::vector<mx::health_risks::Race> race;
+  std::vector<mx::health_risks::ParentalHistory> parental_hypertension;
+  std::vector<mx::health_risks::FamilyHistory> family_diabetes;
+  std::vector<float> triglyceride;
+  std::vector<float> fasting_glucose;
+  std::vector<std::uint8_t> vegetable_fruit_diet;
+  std::vector<std::uint8_t> history_of_high_glucose;
+  std::vector<std::uint8_t> history_of_hypertension;
+
+  std::array<std::vector<std::uint64_t>, kRiskFactorCount> presence;
+
+  // Countries that are neither empty nor two ASCII letters, as (record, country) in increasing record order. Such
+  // records have the Country presence bit set and an empty `country` entry.
+  std::vector<std::pair<std::size_t, std::string>> other_country;
+
+  bool IsPresent(RiskFactor factor, std::size_t i) const {
+    return (presence[static_cast<std::size_t>(factor)][i / 64] >> (i % 64)) & 1;
+  }
+};
+
+/**
+ * Converts a range of risk factors into columnar form, reusing the buffers already allocated by `columns`.
+ */
+void ToColumns(span<const mx::health_risks::RisksFactors> risk_factors, risks_factors_columns& columns);
+
+/**
+ * Reads record `i` of `columns` back into `risk_factors`, reusing its country string buffer. The result is equal to the
+ * record passed to ToColumns.
+ */
+void GetRow(const risks_factors_columns& columns, std::size_t i, mx::health_risks::RisksFactors& risk_factors);
+
+}  // namespace shen
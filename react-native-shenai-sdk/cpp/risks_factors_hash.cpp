@@ -0,0 +1,93 @@
+#include "risks_factors_hash.h"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <string>
+
+#include "country_code.h"
+
+namespace shen {
+
+namespace {
+
+constexpr std::uint64_t kMultiplier = 0x9e3779b97f4a7c15ull;
+
+inline void Mix(std::uint64_t& h, std::uint64_t value) {
+  h ^= value + kMultiplier + (h << 6) + (h >> 2);
+  h *= kMultiplier;
+}
+
+// Floats are keyed on their bit pattern, with -0.0 folded into +0.0, so that a NaN equals itself.
+inline std::uint32_t FloatBits(float value) {
+  float v = value == 0.0f ? 0.0f : value;
+  std::uint32_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+inline bool Same(const std::optional<float>& a, const std::optional<float>& b) {
+  return a.has_value() == b.has_value() && (!a || FloatBits(*a) == FloatBits(*b));
+}
+
+template <typename T>
+inline bool Same(const std::optional<T>& a, const std::optional<T>& b) {
+  return a == b;
+}
+
+// Optional numbers hash their presence and value.
+inline void Mix(std::uint64_t& h, const std::optional<float>& value) {
+  Mix(h, value ? (std::uint64_t{1} << 32) | FloatBits(*value) : 0);
+}
+
+template <typename T>
+inline void Mix(std::uint64_t& h, const std::optional<T>& value) {
+  Mix(h, value ? (std::uint64_t{1} << 32) | static_cast<std::uint32_t>(*value) : 0);
+}
+
+}  // namespace
+
+bool RisksFactorsEqual(const mx::health_risks::RisksFactors& a, const mx::health_risks::RisksFactors& b) {
+  return Same(a.age, b.age) && Same(a.cholesterol, b.cholesterol) && Same(a.cholesterol_hdl, b.cholesterol_hdl) &&
+         Same(a.sbp, b.sbp) && Same(a.dbp, b.dbp) && Same(a.is_smoker, b.is_smoker) &&
+         Same(a.hypertension_treatment, b.hypertension_treatment) && Same(a.has_diabetes, b.has_diabetes) &&
+         Same(a.body_height, b.body_height) && Same(a.body_weight, b.body_weight) &&
+         Same(a.waist_circumference, b.waist_circumference) && Same(a.physical_activity, b.physical_activity) &&
+         Same(a.gender, b.gender) && a.country == b.country && Same(a.race, b.race) &&
+         Same(a.parental_hypertension, b.parental_hypertension) && Same(a.family_diabetes, b.family_diabetes) &&
+         Same(a.triglyceride, b.triglyceride) && Same(a.fasting_glucose, b.fasting_glucose) &&
+         Same(a.vegetable_fruit_diet, b.vegetable_fruit_diet) &&
+         Same(a.history_of_high_glucose, b.history_of_high_glucose) &&
+         Same(a.history_of_hypertension, b.history_of_hypertension);
+}
+
+std::size_t HashRisksFactors(const mx::health_risks::RisksFactors& f) {
+  std::uint64_t h = 0;
+  Mix(h, f.age);
+  Mix(h, f.cholesterol);
+  Mix(h, f.cholesterol_hdl);
+  Mix(h, f.sbp);
+  Mix(h, f.dbp);
+  Mix(h, f.is_smoker);
+  Mix(h, f.hypertension_treatment);
+  Mix(h, f.has_diabetes);
+  Mix(h, f.body_height);
+  Mix(h, f.body_weight);
+  Mix(h, f.waist_circumference);
+  Mix(h, f.physical_activity);
+  Mix(h, f.gender);
+  const std::optional<country_code> country = country_code::FromString(f.country);
+  Mix(h, country ? country->GetValue() : std::hash<std::string>{}(f.country));
+  Mix(h, f.race);
+  Mix(h, f.parental_hypertension);
+  Mix(h, f.family_diabetes);
+  Mix(h, f.triglyceride);
+  Mix(h, f.fasting_glucose);
+  Mix(h, f.vegetable_fruit_diet);
+  Mix(h, f.history_of_high_glucose);
+  Mix(h, f.history_of_hypertension);
+  return static_cast<std::size_t>(h);
+}
+
+}  // namespace shen
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <ShenaiSDK/health_risks_factors.h>
+
+#include <cstddef>
+
+namespace shen {
+
+/**
+ * Field-by-field equality of two sets of risk factors, suitable as a memoization key.
+ * Unlike the operator== declared in health_risks_factors.h, this also compares `dbp`, and it compares floats by their
+ * bit pattern (treating -0.0 as +0.0), so a NaN factor equals itself.
+ */
+bool RisksFactorsEqual(const mx::health_risks::RisksFactors& a, const mx::health_risks::RisksFactors& b);
+
+/**
+ * Hash of a set of risk factors, consistent with RisksFactorsEqual.
+ * It is not consistent with the SDK's operator==, which ignores `dbp`.
+ */
+std::size_t HashRisksFactors(const mx::health_risks::RisksFactors& risk_factors);
+
+struct risks_factors_hash {
+  std::size_t operator()(const mx::health_risks::RisksFactors& risk_factors) const {
+    return HashRisksFactors(risk_factors);
+  }
+};
+
+struct risks_factors_equal {
+  bool operator()(const mx::health_risks::RisksFactors& a, const mx::health_risks::RisksFactors& b) const {
+    return RisksFactorsEqual(a, b);
+  }
+};
+
+}  // namespace shen
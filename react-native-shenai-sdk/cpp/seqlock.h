@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace shen {
+
+/**
+ * A trivially copyable value published by a single writer to any number of readers, as a sequence lock.
+ *
+ * The writer never waits: it bumps the sequence number to odd, stores the value and bumps it back to even. Readers
+ * never take a lock either: they copy the value and retry only if the sequence number shows that a store overlapped
+ * the copy, so a reader is delayed by at most the duration of a store and never delays the writer. The value is kept
+ * as relaxed atomic words so that the racing copy is well-defined.
+ */
+template <typename T>
+class seqlock {
+  static_assert(std::is_trivially_copyable_v<T>, "seqlock requires a trivially copyable type");
+
+ public:
+  seqlock() : seqlock(T{}) {}
+  explicit seqlock(const T& value) { Write(value); }
+
+  seqlock(const seqlock&) = delete;
+  seqlock& operator=(const seqlock&) = delete;
+
+  /**
+   * Publishes `value`. Must only be called from one thread at a time.
+   */
+  void Store(const T& value) {
+    const std::uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Write(value);
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  /**
+   * Gets the latest published value.
+   */
+  T Load() const {
+    std::uint32_t retries = 0;
+    return Load(retries);
+  }
+
+  /**
+   * Gets the latest published value, adding to `retries` the number of copies discarded because a store overlapped
+   * them.
+   */
+  T Load(std::uint32_t& retries) const {
+    std::array<std::uint64_t, kWordCount> words;
+    for (;;) {
+      const std::uint64_t before = sequence_.load(std::memory_order_acquire);
+      if (before & 1) {
+        // The writer is mid-store; let it run in case it shares this core.
+        ++retries;
+        std::this_thread::yield();
+        continue;
+      }
+      for (std::size_t i = 0; i < kWordCount; ++i) {
+        words[i] = words_[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence_.load(std::memory_order_relaxed) == before) {
+        break;
+      }
+      ++retries;
+    }
+    T value;
+    std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+    return value;
+  }
+
+  /**
+   * Gets the number of stores so far.
+   */
+  std::uint64_t GetVersion() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+ private:
+  static constexpr std::size_t kWordCount = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+  void Write(const T& value) {
+    std::array<std::uint64_t, kWordCount> words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+    for (std::size_t i = 0; i < kWordCount; ++i) {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  alignas(64) std::atomic<std::uint64_t> sequence_{0};
+  std::array<std::atomic<std::uint64_t>, kWordCount> words_;
+};
+
+}  // namespace shen
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace shen {
+
+/**
+ * Non-owning view over a contiguous range of elements.
+ * A minimal C++17 stand-in for std::span, used by the batch entry points of the native helpers.
+ */
+template <typename T>
+class span {
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+  using iterator = T*;
+
+  constexpr span() noexcept = default;
+  constexpr span(T* data, size_type size) noexcept : data_(data), size_(size) {}
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+  constexpr span(span<U> other) noexcept : data_(other.data()), size_(other.size()) {}
+
+  template <typename Container,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::remove_cv_t<Container>, span> &&
+                std::is_convertible_v<std::remove_pointer_t<decltype(std::declval<Container&>().data())> (*)[],
+                                      T (*)[]>>>
+  constexpr span(Container& container) noexcept : data_(container.data()), size_(container.size()) {}
+
+  constexpr T* data() const noexcept { return data_; }
+  constexpr size_type size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+
+  constexpr T& operator[](size_type i) const noexcept { return data_[i]; }
+  constexpr iterator begin() const noexcept { return data_; }
+  constexpr iterator end() const noexcept { return data_ + size_; }
+
+  constexpr span first(size_type count) const noexcept { return {data_, count}; }
+  constexpr span subspan(size_type offset, size_type count) const noexcept { return {data_ + offset, count}; }
+  constexpr span subspan(size_type offset) const noexcept { return {data_ + offset, size_ - offset}; }
+
+ private:
+  T* data_{nullptr};
+  size_type size_{0};
+};
+
+}  // namespace shen
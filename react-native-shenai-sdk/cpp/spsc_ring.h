@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "span.h"
+
+namespace shen {
+
+/**
+ * Bounded lock-free queue with a single producer thread and a single consumer thread.
+ * The capacity is rounded up to a power of two. Each side keeps a cached copy of the other side's index, so the shared
+ * indices are only read when the cached one says the queue looks full (producer) or empty (consumer).
+ */
+template <typename T>
+class spsc_ring {
+ public:
+  explicit spsc_ring(std::size_t capacity) : slots_(RoundUpToPowerOfTwo(capacity)), mask_(slots_.size() - 1) {}
+
+  spsc_ring(const spsc_ring&) = delete;
+  spsc_ring& operator=(const spsc_ring&) = delete;
+
+  std::size_t GetCapacity() const { return slots_.size(); }
+
+  /**
+   * Gets the number of queued elements. Exact only when called from the producer or the consumer while the other side
+   * is idle.
+   */
+  std::size_t GetSize() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Enqueues `value`. Producer only.
+   * @return False, leaving the queue unchanged, if it is full.
+   */
+  bool TryPush(const T& value) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head - producer_cached_tail_ == slots_.size()) {
+      producer_cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head - producer_cached_tail_ == slots_.size()) {
+        return false;
+      }
+    }
+    slots_[head & mask_] = value;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Dequeues the oldest element into `value`. Consumer only.
+   * @return False if the queue is empty.
+   */
+  bool TryPop(T& value) { return Pop(span<T>(&value, 1)) == 1; }
+
+  /**
+   * Dequeues up to `out.size()` of the oldest elements into `out`. Consumer only.
+   * @return The number of elements dequeued.
+   */
+  std::size_t Pop(span<T> out) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (consumer_cached_head_ - tail < out.size()) {
+      consumer_cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    const std::size_t count = std::min(consumer_cached_head_ - tail, out.size());
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = slots_[(tail + i) & mask_];
+    }
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+ private:
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  static std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  std::vector<T> slots_;
+  std::size_t mask_;
+
+  alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};  // next slot to write
+  std::size_t producer_cached_tail_{0};
+
+  alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};  // next slot to read
+  std::size_t consumer_cached_head_{0};
+};
+
+}  // namespace shen
@@ -0,0 +1,137 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace shen {
+
+namespace {
+
+// Pool whose chunks the current thread is running, if any.
+thread_local const thread_pool* t_running_pool = nullptr;
+
+class running_pool_scope {
+ public:
+  explicit running_pool_scope(const thread_pool* pool) : previous_(t_running_pool) { t_running_pool = pool; }
+  ~running_pool_scope() { t_running_pool = previous_; }
+
+  running_pool_scope(const running_pool_scope&) = delete;
+  running_pool_scope& operator=(const running_pool_scope&) = delete;
+
+ private:
+  const thread_pool* previous_;
+};
+
+}  // namespace
+
+thread_pool::thread_pool(unsigned num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  workers_.reserve(num_threads - 1);
+  for (unsigned i = 1; i < num_threads; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+thread_pool::~thread_pool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void thread_pool::ParallelFor(std::size_t count, std::size_t grain_size,
+                              const std::function<void(std::size_t, std::size_t)>& fn) {
+  if (IsRunningOnCurrentThread()) {
+    throw std::logic_error("ParallelFor called from a chunk of the same pool");
+  }
+  if (count == 0) {
+    return;
+  }
+  grain_size = std::max<std::size_t>(grain_size, 1);
+  if (workers_.empty() || count <= grain_size) {
+    fn(0, count);
+    return;
+  }
+
+  std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fn_ = &fn;
+    count_ = count;
+    grain_size_ = grain_size;
+    next_chunk_.store(0, std::memory_order_relaxed);
+    failed_.store(false, std::memory_order_relaxed);
+    error_ = nullptr;
+    active_workers_ = workers_.size();
+    ++generation_;
+  }
+  wake_.notify_all();
+
+  {
+    running_pool_scope scope(this);
+    RunChunks();
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return active_workers_ == 0; });
+  fn_ = nullptr;
+  if (error_) {
+    std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+}
+
+void thread_pool::WorkerLoop() {
+  running_pool_scope scope(this);
+  std::uint64_t seen_generation = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+      if (stop_) {
+        return;
+      }
+      seen_generation = generation_;
+    }
+
+    RunChunks();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--active_workers_ == 0) {
+      done_.notify_one();
+    }
+  }
+}
+
+void thread_pool::RunChunks() {
+  while (!failed_.load(std::memory_order_relaxed)) {
+    std::size_t begin = next_chunk_.fetch_add(1, std::memory_order_relaxed) * grain_size_;
+    if (begin >= count_) {
+      return;
+    }
+    try {
+      (*fn_)(begin, std::min(begin + grain_size_, count_));
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+      failed_.store(true, std::memory_order_relaxed);
+    }
+  }
+}
+
+bool thread_pool::IsRunningOnCurrentThread() const { return t_running_pool == this; }
+
+thread_pool& DefaultThreadPool() {
+  static thread_pool pool;
+  return pool;
+}
+
+}  // namespace shen
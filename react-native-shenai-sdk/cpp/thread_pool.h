@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace shen {
+
+/**
+ * Fixed-size pool of worker threads used by the batch entry points.
+ * Work is handed out in chunks through a shared atomic counter, so uneven per-record cost is balanced across threads
+ * and throughput scales with the number of cores.
+ *
+ * The batch entry points call the SDK's health-risk and BMI functions from all the threads of the pool at once. They
+ * assume these functions are safe to call concurrently, as pure functions of their arguments, which the SDK does not
+ * document. Passing a pool created with `num_threads = 1` keeps every call on the calling thread.
+ */
+class thread_pool {
+ public:
+  /**
+   * Creates the pool.
+   * @param num_threads The total number of threads taking part in a ParallelFor, including the calling thread.
+   * 0 selects std::thread::hardware_concurrency().
+   */
+  explicit thread_pool(unsigned num_threads = 0);
+  ~thread_pool();
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /**
+   * Gets the number of threads taking part in a ParallelFor, including the calling thread.
+   */
+  unsigned GetThreadCount() const { return static_cast<unsigned>(workers_.size()) + 1; }
+
+  /**
+   * Runs `fn(begin, end)` over [0, count) split into chunks of at most `grain_size` elements and blocks until all the
+   * chunks have finished. The calling thread processes chunks as well. Concurrent calls are serialized.
+   * If `fn` throws, no further chunks are started, and the first exception is rethrown on the calling thread once the
+   * chunks already running have finished.
+   * @throws std::logic_error If called from inside `fn` of a ParallelFor of the same pool, which would deadlock. From a
+   * worker thread, the exception ends the outer ParallelFor like any other exception thrown by its `fn`.
+   */
+  void ParallelFor(std::size_t count, std::size_t grain_size,
+                   const std::function<void(std::size_t /*begin*/, std::size_t /*end*/)>& fn);
+
+  /**
+   * Checks whether the calling thread is running a chunk of a ParallelFor of this pool, where ParallelFor must not be
+   * called again. Entry points that may be called from inside a chunk use it to run on the calling thread instead.
+   */
+  bool IsRunningOnCurrentThread() const;
+
+ private:
+  void WorkerLoop();
+  void RunChunks();
+
+  std::vector<std::thread> workers_;
+
+  std::mutex submit_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  std::uint64_t generation_{0};
+  std::size_t active_workers_{0};
+  bool stop_{false};
+
+  const std::function<void(std::size_t, std::size_t)>* fn_{nullptr};
+  std::size_t count_{0};
+  std::size_t grain_size_{1};
+  std::atomic<std::size_t> next_chunk_{0};
+  std::atomic<bool> failed_{false};
+  std::exception_ptr error_;  // first exception thrown by fn_, guarded by mutex_
+};
+
+/**
+ * Gets the process-wide pool used when no pool is passed explicitly.
+ * The pool is created on first use with std::thread::hardware_concurrency() threads.
+ */
+thread_pool& DefaultThreadPool();
+
+}  // namespace shen